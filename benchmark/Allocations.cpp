@@ -0,0 +1,55 @@
+#include "Benchmark.h"
+
+#include <cstdlib>
+#include <new>
+
+std::atomic<std::uint64_t> Benchmark::Allocations::s_Count{ 0 };
+std::atomic<std::uint64_t> Benchmark::Allocations::s_Bytes{ 0 };
+
+// Replacement of global allocation functions, counting every allocation made by the benchmark executable.
+void* operator new(std::size_t size)
+{
+	Benchmark::Allocations::s_Count.fetch_add(1, std::memory_order_relaxed);
+	Benchmark::Allocations::s_Bytes.fetch_add(size, std::memory_order_relaxed);
+	if (auto ptr = std::malloc(size ? size : 1))
+		return ptr;
+
+	throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept
+{
+	Benchmark::Allocations::s_Count.fetch_add(1, std::memory_order_relaxed);
+	Benchmark::Allocations::s_Bytes.fetch_add(size, std::memory_order_relaxed);
+	return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, std::nothrow_t const& tag) noexcept
+{
+	return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
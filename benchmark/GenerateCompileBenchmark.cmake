@@ -0,0 +1,48 @@
+# Generates translation unit instantiating serialization of many large types.
+# Used to track template instantiation cost of ByteConverter headers.
+#
+# Arguments:
+#   OUTPUT - path of generated source file.
+#   TYPES  - number of generated structures.
+#   FIELDS - number of members in each structure.
+function(GenerateCompileBenchmark OUTPUT TYPES FIELDS)
+	set(memberTypes "uint8_t" "uint16_t" "uint32_t" "uint64_t" "int32_t" "double" "float" "bool" "std::string" "std::vector<uint32_t>" "std::pair<uint16_t, std::string>" "std::map<std::string, uint64_t>")
+	list(LENGTH memberTypes memberTypeCount)
+
+	set(source "// Generated by GenerateCompileBenchmark.cmake. Do not edit.\n")
+	string(APPEND source "#include \"FSecure/ByteConverter/ByteConverter.h\"\n\n#include <map>\n\n")
+	string(APPEND source "namespace CompileBenchmark\n{\n")
+	math(EXPR lastType "${TYPES} - 1")
+	math(EXPR lastField "${FIELDS} - 1")
+	foreach(type RANGE ${lastType})
+		string(APPEND source "\tstruct Type${type}\n\t{\n")
+		foreach(field RANGE ${lastField})
+			math(EXPR memberTypeIndex "(${type} + ${field}) % ${memberTypeCount}")
+			list(GET memberTypes ${memberTypeIndex} memberType)
+			string(APPEND source "\t\t${memberType} m_${field}{};\n")
+		endforeach()
+		string(APPEND source "\t};\n\n")
+	endforeach()
+	string(APPEND source "}\n\nnamespace FSecure\n{\n")
+	foreach(type RANGE ${lastType})
+		set(members "")
+		foreach(field RANGE ${lastField})
+			if(field EQUAL 0)
+				string(APPEND members "obj.m_${field}")
+			else()
+				string(APPEND members ", obj.m_${field}")
+			endif()
+		endforeach()
+		string(APPEND source "\ttemplate <>\n\tstruct ByteConverter<CompileBenchmark::Type${type}> : TupleConverter<CompileBenchmark::Type${type}>\n\t{\n")
+		string(APPEND source "\t\tstatic auto Convert(CompileBenchmark::Type${type} const& obj)\n\t\t{\n\t\t\treturn Utils::MakeConversionTuple(${members});\n\t\t}\n\t};\n\n")
+	endforeach()
+	string(APPEND source "}\n\nsize_t CompileBenchmarkRoundTrip()\n{\n\tauto size = size_t{ 0 };\n")
+	foreach(type RANGE ${lastType})
+		string(APPEND source "\t{\n\t\tauto bv = FSecure::ByteVector::Create(CompileBenchmark::Type${type}{});\n")
+		string(APPEND source "\t\tsize += FSecure::ByteVector::Size(FSecure::ByteView{ bv }.Read<CompileBenchmark::Type${type}>());\n\t}\n")
+	endforeach()
+	string(APPEND source "\treturn size;\n}\n")
+
+	file(WRITE "${OUTPUT}.tmp" "${source}")
+	configure_file("${OUTPUT}.tmp" "${OUTPUT}" COPYONLY)
+endfunction()
@@ -0,0 +1,86 @@
+#include "ConverterBenchmark.h"
+#include "Dataset.h"
+
+using namespace FSecure;
+
+BYTE_CONVERTER_BENCHMARK("Arithmetic")
+{
+	auto generator = Dataset::Generator{};
+	auto scale = runner.GetSettings().m_Scale;
+	Benchmark::MeasureConverter(runner, "arithmetic/uint64_t", generator.Many(scale, [&] { return generator.Number<uint64_t>(); }));
+	Benchmark::MeasureConverter(runner, "arithmetic/double", generator.Many(scale, [&] { return static_cast<double>(generator.Number<int64_t>()) / 3; }));
+}
+
+BYTE_CONVERTER_BENCHMARK("Enum")
+{
+	auto generator = Dataset::Generator{};
+	Benchmark::MeasureConverter(runner, "enum", generator.Many(runner.GetSettings().m_Scale, [&] { return static_cast<Dataset::Kind>(generator.Number<uint16_t>(0, 2)); }));
+}
+
+BYTE_CONVERTER_BENCHMARK("Iterable")
+{
+	auto generator = Dataset::Generator{};
+	auto scale = runner.GetSettings().m_Scale;
+	Benchmark::MeasureConverter(runner, "iterable/vector<uint32_t>", generator.Many(16, [&] { return generator.Many(scale, [&] { return generator.Number<uint32_t>(); }); }));
+	Benchmark::MeasureConverter(runner, "iterable/string", generator.Many(16, [&] { return generator.String(scale); }));
+	Benchmark::MeasureConverter(runner, "iterable/wstring", generator.Many(16, [&] { return generator.String<std::wstring>(scale); }));
+	Benchmark::MeasureConverter(runner, "iterable/vector<string>", generator.Many(16, [&] { return generator.Many(scale, [&] { return generator.String(16); }); }));
+	Benchmark::MeasureConverter(runner, "iterable/unordered_map<string,string>", generator.Many(16, [&]
+		{
+			auto ret = std::unordered_map<std::string, std::string>{};
+			for (auto i = size_t{ 0 }; i < scale; ++i)
+				ret.emplace(generator.String(16), generator.String(32));
+
+			return ret;
+		}));
+}
+
+BYTE_CONVERTER_BENCHMARK("Path")
+{
+	auto generator = Dataset::Generator{};
+	Benchmark::MeasureConverter(runner, "path", generator.Many(16, [&] { return std::filesystem::path{ generator.String(16) } / generator.String(runner.GetSettings().m_Scale); }));
+}
+
+BYTE_CONVERTER_BENCHMARK("Variant")
+{
+	using Variant = std::variant<uint64_t, std::string>;
+	auto generator = Dataset::Generator{};
+	auto scale = runner.GetSettings().m_Scale;
+	Benchmark::MeasureConverter(runner, "variant", generator.Many(scale, [&]
+		{
+			return generator.Number<uint8_t>(0, 1) ? Variant{ generator.Number<uint64_t>() } : Variant{ generator.String(16) };
+		}));
+}
+
+BYTE_CONVERTER_BENCHMARK("Tuple")
+{
+	auto generator = Dataset::Generator{};
+	auto scale = runner.GetSettings().m_Scale;
+	Benchmark::MeasureConverter(runner, "tuple<uint32_t,uint64_t,double>", generator.Many(scale, [&] { return std::tuple{ generator.Number<uint32_t>(), generator.Number<uint64_t>(), 1.5 }; }));
+	Benchmark::MeasureConverter(runner, "tuple<string,uint64_t,string>", generator.Many(scale, [&] { return std::tuple{ generator.String(16), generator.Number<uint64_t>(), generator.String(scale) }; }));
+}
+
+BYTE_CONVERTER_BENCHMARK("Bytes")
+{
+	constexpr auto chunk = size_t{ 64 };
+	auto generator = Dataset::Generator{};
+	auto buffer = ByteVector{};
+	for (auto i = size_t{ 0 }; i < runner.GetSettings().m_Scale; ++i)
+		buffer.Concat(ByteView{ generator.String(chunk) });
+
+	runner.Measure("bytes/read", chunk, [&, view = ByteView{ buffer }]() mutable
+		{
+			if (view.size() < chunk)
+				view = buffer;
+
+			Benchmark::DoNotOptimize(view.Read<Bytes<chunk>>());
+		});
+
+	runner.Measure("bytes-copy/read", chunk, [&, view = ByteView{ buffer }]() mutable
+		{
+			if (view.size() < chunk)
+				view = buffer;
+
+			Benchmark::DoNotOptimize(view.Read<BytesCopy<chunk>>());
+		});
+}
@@ -0,0 +1,52 @@
+#include "ConverterBenchmark.h"
+#include "Dataset.h"
+
+using namespace FSecure;
+
+namespace FSecure
+{
+	template <>
+	struct ByteConverter<Dataset::Record> : TupleConverter<Dataset::Record>
+	{
+		static auto Convert(Dataset::Record const& obj)
+		{
+			return Utils::MakeConversionTuple(
+				obj.number,
+				obj.kind,
+				obj.string,
+				obj.wstring,
+				obj.path,
+				obj.tuple,
+				obj.array,
+				obj.hashmap,
+				obj.vector,
+				obj.variant
+			);
+		}
+	};
+
+	template <>
+	struct ByteConverter<Dataset::Reading> : PointerTupleConverter<Dataset::Reading>
+	{
+		static auto MemberPointers()
+		{
+			return std::make_tuple(&Dataset::Reading::sensor, &Dataset::Reading::sequence, &Dataset::Reading::timestamp, &Dataset::Reading::value);
+		}
+	};
+}
+
+BYTE_CONVERTER_BENCHMARK("TupleConverter")
+{
+	auto generator = Dataset::Generator{};
+	auto scale = runner.GetSettings().m_Scale;
+	Benchmark::MeasureConverter(runner, "tuple-converter/record", generator.Many(16, [&] { return generator.MakeRecord(scale); }));
+	Benchmark::MeasureConverter(runner, "tuple-converter/vector<record>", generator.Many(4, [&] { return generator.Many(scale / 8 + 1, [&] { return generator.MakeRecord(scale); }); }));
+}
+
+BYTE_CONVERTER_BENCHMARK("PointerTupleConverter")
+{
+	auto generator = Dataset::Generator{};
+	auto scale = runner.GetSettings().m_Scale;
+	Benchmark::MeasureConverter(runner, "pointer-tuple-converter/reading", generator.Many(scale, [&] { return generator.MakeReading(); }));
+	Benchmark::MeasureConverter(runner, "pointer-tuple-converter/vector<reading>", generator.Many(16, [&] { return generator.Many(scale, [&] { return generator.MakeReading(); }); }));
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/// Minimal, dependency free benchmark harness.
+/// Cases are registered with BYTE_CONVERTER_BENCHMARK and receive Runner, which measures any number of operations.
+namespace Benchmark
+{
+	/// Allocation counters maintained by replaced global operator new. @see Allocations.cpp
+	struct Allocations
+	{
+		static std::atomic<std::uint64_t> s_Count;
+		static std::atomic<std::uint64_t> s_Bytes;
+	};
+
+	/// Prevents compiler from optimizing out computation of value.
+	/// @param value. Result of measured operation.
+	template <typename T>
+	inline void DoNotOptimize(T const& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &value;
+#endif
+	}
+
+	/// Settings parsed from command line.
+	struct Settings
+	{
+		/// Number of elements in generated datasets.
+		size_t m_Scale = 64;
+
+		/// Minimal time spent in each measurement.
+		std::chrono::milliseconds m_MinTime{ 200 };
+
+		/// Only operations containing this string are measured.
+		std::string m_Filter;
+	};
+
+	/// Single measurement result.
+	struct Result
+	{
+		std::string m_Name;
+		std::uint64_t m_Iterations;
+		double m_NanosecondsPerOperation;
+		double m_BytesPerSecond;
+		double m_AllocationsPerOperation;
+	};
+
+	/// Performs and reports measurements.
+	class Runner
+	{
+	public:
+		/// Create runner.
+		/// @param settings. Options for all measurements.
+		explicit Runner(Settings settings)
+			: m_Settings{ std::move(settings) }
+		{
+		}
+
+		/// Get runner settings.
+		Settings const& GetSettings() const
+		{
+			return m_Settings;
+		}
+
+		/// Repeat operation until minimal time elapses, and report results.
+		/// @param name. Name of measured operation.
+		/// @param bytesPerOperation. Number of bytes processed by one call of operation.
+		/// @param operation. Callable that will be measured.
+		template <typename Operation>
+		void Measure(std::string const& name, size_t bytesPerOperation, Operation&& operation)
+		{
+			if (!m_Settings.m_Filter.empty() && name.find(m_Settings.m_Filter) == std::string::npos)
+				return;
+
+			using Clock = std::chrono::steady_clock;
+			operation(); // warm up caches and lazily initialized state.
+
+			auto iterations = std::uint64_t{ 1 };
+			while (true)
+			{
+				auto allocations = Allocations::s_Count.load(std::memory_order_relaxed);
+				auto start = Clock::now();
+				for (auto i = std::uint64_t{ 0 }; i < iterations; ++i)
+					operation();
+
+				auto elapsed = Clock::now() - start;
+				allocations = Allocations::s_Count.load(std::memory_order_relaxed) - allocations;
+				if (elapsed >= m_Settings.m_MinTime || iterations >= (std::uint64_t{ 1 } << 40))
+				{
+					auto nanoseconds = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+					auto nsPerOp = nanoseconds / static_cast<double>(iterations);
+					Report({ name, iterations, nsPerOp, nsPerOp > 0 ? bytesPerOperation * 1e9 / nsPerOp : 0.0, static_cast<double>(allocations) / static_cast<double>(iterations) });
+					return;
+				}
+
+				iterations *= 2;
+			}
+		}
+
+		/// Get all collected results.
+		std::vector<Result> const& GetResults() const
+		{
+			return m_Results;
+		}
+
+	private:
+		/// Print and store result.
+		void Report(Result result);
+
+		/// Options for all measurements.
+		Settings m_Settings;
+
+		/// Collected measurements.
+		std::vector<Result> m_Results;
+	};
+
+	/// Registered benchmark case.
+	struct Case
+	{
+		std::string m_Name;
+		std::function<void(Runner&)> m_Body;
+	};
+
+	/// Get list of all registered cases.
+	inline std::vector<Case>& Cases()
+	{
+		static std::vector<Case> cases;
+		return cases;
+	}
+
+	/// Registers case during static initialization.
+	struct Registrar
+	{
+		Registrar(std::string name, std::function<void(Runner&)> body)
+		{
+			Cases().push_back({ std::move(name), std::move(body) });
+		}
+	};
+}
+
+#define BYTE_CONVERTER_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define BYTE_CONVERTER_BENCHMARK_CONCAT(a, b) BYTE_CONVERTER_BENCHMARK_CONCAT_IMPL(a, b)
+
+/// Define benchmark case. Body receives Benchmark::Runner& runner.
+#define BYTE_CONVERTER_BENCHMARK(name) \
+	static void BYTE_CONVERTER_BENCHMARK_CONCAT(BenchmarkCase, __LINE__)(Benchmark::Runner& runner); \
+	static Benchmark::Registrar BYTE_CONVERTER_BENCHMARK_CONCAT(BenchmarkRegistrar, __LINE__){ name, &BYTE_CONVERTER_BENCHMARK_CONCAT(BenchmarkCase, __LINE__) }; \
+	static void BYTE_CONVERTER_BENCHMARK_CONCAT(BenchmarkCase, __LINE__)([[maybe_unused]] Benchmark::Runner& runner)
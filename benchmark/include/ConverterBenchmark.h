@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Benchmark.h"
+#include "FSecure/ByteConverter/ByteConverter.h"
+
+namespace Benchmark
+{
+	/// Measure Write, Size and Read of one type.
+	/// Each operation processes a single object, cycling through provided dataset.
+	/// @param runner. Runner performing measurements.
+	/// @param name. Prefix of reported operation names.
+	/// @param dataset. Objects used as input.
+	template <typename T>
+	void MeasureConverter(Runner& runner, std::string const& name, std::vector<T> const& dataset)
+	{
+		using namespace FSecure;
+
+		auto serialized = std::vector<ByteVector>{};
+		auto totalSize = size_t{ 0 };
+		for (auto const& e : dataset)
+		{
+			serialized.push_back(ByteVector::Create(e));
+			totalSize += serialized.back().size();
+		}
+
+		auto bytesPerOperation = totalSize / dataset.size();
+		auto index = size_t{ 0 };
+		auto next = [&index, count = dataset.size()]{ auto ret = index; index = (index + 1) % count; return ret; };
+
+		runner.Measure(name + "/write", bytesPerOperation, [&] { DoNotOptimize(ByteVector::Create(dataset[next()])); });
+		runner.Measure(name + "/size", bytesPerOperation, [&] { DoNotOptimize(ByteVector::Size(dataset[next()])); });
+		runner.Measure(name + "/read", bytesPerOperation, [&] { DoNotOptimize(ByteView{ serialized[next()] }.Read<T>()); });
+	}
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+/// Deterministic data generation for benchmarks.
+/// Every run produces the same datasets, so results are comparable between builds.
+namespace Dataset
+{
+	enum class Kind : uint16_t
+	{
+		foo,
+		bar,
+		baz,
+	};
+
+	/// Structure resembling TestFixture::CustomType, covering all built-in converters.
+	struct Record
+	{
+		int number;
+		Kind kind;
+		std::string string;
+		std::wstring wstring;
+		std::filesystem::path path;
+		std::tuple<std::string, uint64_t, double> tuple;
+		std::array<std::byte, 12> array;
+		std::unordered_map<std::string, std::string> hashmap;
+		std::vector<uint32_t> vector;
+		std::variant<uint64_t, std::string> variant;
+	};
+
+	/// Trivially serializable structure.
+	struct Reading
+	{
+		uint16_t sensor;
+		uint32_t sequence;
+		uint64_t timestamp;
+		double value;
+	};
+
+	/// Source of pseudo random values.
+	class Generator
+	{
+	public:
+		/// Create generator.
+		/// @param seed. Seed of pseudo random engine.
+		explicit Generator(uint32_t seed = 0x5eed)
+			: m_Engine{ seed }
+		{
+		}
+
+		/// Generate integral value from range.
+		template <typename T>
+		T Number(T from = std::numeric_limits<T>::min(), T to = std::numeric_limits<T>::max())
+		{
+			using Distributed = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
+			return static_cast<T>(std::uniform_int_distribution<Distributed>{ static_cast<Distributed>(from), static_cast<Distributed>(to) }(m_Engine));
+		}
+
+		/// Generate string of alphanumeric characters.
+		template <typename T = std::string>
+		T String(size_t size)
+		{
+			constexpr std::string_view charset = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+			T ret;
+			ret.resize(size);
+			for (auto& e : ret)
+				e = static_cast<typename T::value_type>(charset[Number<size_t>(0, charset.size() - 1)]);
+
+			return ret;
+		}
+
+		/// Generate record. Length of strings and containers grows with scale.
+		Record MakeRecord(size_t scale)
+		{
+			auto record = Record{};
+			record.number = Number<int>();
+			record.kind = static_cast<Kind>(Number<uint16_t>(0, 2));
+			record.string = String(8 + scale);
+			record.wstring = String<std::wstring>(8 + scale);
+			record.path = std::filesystem::path{ "benchmark" } / String(16);
+			record.tuple = { String(scale), Number<uint64_t>(), 3.14 };
+			for (auto& e : record.array)
+				e = static_cast<std::byte>(Number<uint8_t>());
+
+			for (auto i = size_t{ 0 }; i < scale / 4 + 1; ++i)
+				record.hashmap.emplace(String(16), String(32));
+
+			record.vector.resize(scale);
+			for (auto& e : record.vector)
+				e = Number<uint32_t>();
+
+			if (Number<uint8_t>(0, 1))
+				record.variant = Number<uint64_t>();
+			else
+				record.variant = String(scale);
+
+			return record;
+		}
+
+		/// Generate sensor reading.
+		Reading MakeReading()
+		{
+			return { Number<uint16_t>(), Number<uint32_t>(), Number<uint64_t>(), 2.71 };
+		}
+
+		/// Generate collection of objects.
+		/// @param count. Number of elements.
+		/// @param make. Functor generating one element.
+		template <typename Make>
+		auto Many(size_t count, Make&& make)
+		{
+			std::vector<decltype(make())> ret;
+			ret.reserve(count);
+			for (auto i = size_t{ 0 }; i < count; ++i)
+				ret.push_back(make());
+
+			return ret;
+		}
+
+	private:
+		/// Pseudo random engine.
+		std::mt19937_64 m_Engine;
+	};
+}
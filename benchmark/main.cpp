@@ -0,0 +1,48 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+void Benchmark::Runner::Report(Result result)
+{
+	std::printf("%-52s %12llu %14.2f %12.2f %10.2f\n", result.m_Name.c_str(), static_cast<unsigned long long>(result.m_Iterations),
+		result.m_NanosecondsPerOperation, result.m_BytesPerSecond / (1024.0 * 1024.0), result.m_AllocationsPerOperation);
+	std::fflush(stdout);
+	m_Results.push_back(std::move(result));
+}
+
+namespace
+{
+	void PrintUsage(char const* program)
+	{
+		std::printf("Usage: %s [--scale N] [--min-time MILLISECONDS] [--filter SUBSTRING]\n", program);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	auto settings = Benchmark::Settings{};
+	for (auto i = 1; i < argc; ++i)
+	{
+		auto hasValue = i + 1 < argc;
+		if (!std::strcmp(argv[i], "--scale") && hasValue)
+			settings.m_Scale = std::strtoull(argv[++i], nullptr, 10);
+		else if (!std::strcmp(argv[i], "--min-time") && hasValue)
+			settings.m_MinTime = std::chrono::milliseconds{ std::strtoll(argv[++i], nullptr, 10) };
+		else if (!std::strcmp(argv[i], "--filter") && hasValue)
+			settings.m_Filter = argv[++i];
+		else
+			return PrintUsage(argv[0]), EXIT_FAILURE;
+	}
+
+	if (!settings.m_Scale)
+		return PrintUsage(argv[0]), EXIT_FAILURE;
+
+	std::printf("%-52s %12s %14s %12s %10s\n", "operation", "iterations", "ns/op", "MiB/s", "allocs/op");
+	auto runner = Benchmark::Runner{ settings };
+	for (auto const& benchmarkCase : Benchmark::Cases())
+		benchmarkCase.m_Body(runner);
+
+	return EXIT_SUCCESS;
+}
@@ -9,13 +9,15 @@ A header-only library for lightweight serialization
 // beware of cross-platform issues
 """
     generators = "cmake"
-    exports_sources = "CMakeLists.txt", "src/*", "test/*"
+    exports_sources = "CMakeLists.txt", "src/*", "test/*", "benchmark/*"
     no_copy_source=True
     options = {
         "build_tests": [True, False],
+        "build_benchmarks": [True, False],
     }
     default_options = {
-        "build_tests": False
+        "build_tests": False,
+        "build_benchmarks": False
     }
 
     _cmake = None
@@ -29,14 +31,16 @@ A header-only library for lightweight serialization
             return self._cmake
         self._cmake = CMake(self)
         self._cmake.definitions["ByteConverterBuildTests"] = self.options.build_tests
+        self._cmake.definitions["ByteConverterBuildBenchmarks"] = self.options.build_benchmarks
         self._cmake.configure()
         return self._cmake
 
     def build(self):
-        if self.options.build_tests:
+        if self.options.build_tests or self.options.build_benchmarks:
             cmake = self._configure_cmake()
             cmake.build()
-            cmake.test()
+            if self.options.build_tests:
+                cmake.test()
 
     def package(self):
         cmake = self._configure_cmake()
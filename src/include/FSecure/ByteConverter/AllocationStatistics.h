@@ -0,0 +1,321 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/// Maximal number of distinct call sites that can be recorded. Calls from sites registered above this limit are counted only per operation.
+#ifndef BYTE_CONVERTER_ALLOCATION_SITES
+#	define BYTE_CONVERTER_ALLOCATION_SITES 256
+#endif
+
+namespace FSecure
+{
+	/// Accounting of ByteVector buffer allocations made by Write, Concat and Create.
+	/// Always compiled in, but disabled by default. When disabled, each call pays for one relaxed atomic load.
+	/// Nested calls made by converters are attributed to the outermost call.
+	/// Counters are kept per operation, and per call site for calls, which provide CallSite.
+	class AllocationStatistics
+	{
+	public:
+		/// Operation that is accounted.
+		enum class Operation
+		{
+			write,
+			concat,
+			create,
+		};
+
+		/// Values accumulated for one operation.
+		struct Counters
+		{
+			/// Number of calls.
+			std::uint64_t m_Calls = 0;
+
+			/// Number of buffers allocated, when ByteVector had no capacity.
+			std::uint64_t m_Allocations = 0;
+
+			/// Number of buffers reallocated to increase capacity.
+			std::uint64_t m_Reallocations = 0;
+
+			/// Number of bytes moved to new buffer during reallocations.
+			std::uint64_t m_BytesCopied = 0;
+
+			/// Sum of unused capacity left after each call.
+			std::uint64_t m_CapacitySlack = 0;
+		};
+
+		/// Location in source code, from which accounted operation was called.
+		struct CallSite
+		{
+			/// Name of source file. Null if location is unknown.
+			char const* m_File = nullptr;
+
+			/// Line in source file.
+			unsigned m_Line = 0;
+
+			/// Get location of caller.
+			/// Pass it as first argument of ByteVector::Write, Concat or Create, to attribute call to its site.
+			/// @code bv.Write(AllocationStatistics::CallSite::Current(), a, b, c); @endcode
+			/// @param file. Name of source file, filled by compiler.
+			/// @param line. Line in source file, filled by compiler.
+			static constexpr CallSite Current(char const* file = __builtin_FILE(), unsigned line = __builtin_LINE())
+			{
+				return { file, line };
+			}
+		};
+
+		/// Values accumulated for one operation called from one site.
+		struct SiteCounters
+		{
+			/// Location of calls.
+			CallSite m_Site;
+
+			/// Operation that was called.
+			Operation m_Operation;
+
+			/// Accumulated values.
+			Counters m_Counters;
+		};
+
+		/// Turn accounting on or off at runtime.
+		/// @param enabled. New state.
+		static void Enable(bool enabled = true)
+		{
+			State().m_Enabled.store(enabled, std::memory_order_relaxed);
+		}
+
+		/// Check if accounting is turned on.
+		static bool IsEnabled()
+		{
+			return State().m_Enabled.load(std::memory_order_relaxed);
+		}
+
+		/// Get values accumulated for operation since last Reset.
+		/// @param operation. Operation to query.
+		static Counters Get(Operation operation)
+		{
+			return State().m_Counters[static_cast<size_t>(operation)].Load();
+		}
+
+		/// Get values accumulated for each call site since last Reset.
+		/// Sites without calls since last Reset are omitted. Calls without known location are counted only per operation.
+		/// @return counters of call sites, in order of registration.
+		static std::vector<SiteCounters> Sites()
+		{
+			auto ret = std::vector<SiteCounters>{};
+			for (auto const& site : State().m_Sites)
+			{
+				if (site.m_State.load(std::memory_order_acquire) != SiteState::ready)
+					continue;
+
+				auto counters = site.m_Counters.Load();
+				if (counters.m_Calls)
+					ret.push_back({ site.m_Site, site.m_Operation, counters });
+			}
+
+			return ret;
+		}
+
+		/// Zero all counters. Registered call sites are kept.
+		static void Reset()
+		{
+			for (auto& counters : State().m_Counters)
+				counters.Clear();
+
+			for (auto& site : State().m_Sites)
+				site.m_Counters.Clear();
+		}
+
+		/// Measures one call of accounted operation.
+		/// Only outermost call on each thread is recorded.
+		class Probe
+		{
+		public:
+			/// Start measurement.
+			/// @param operation. Measured operation.
+			/// @param capacity. Capacity of ByteVector before operation.
+			/// @param size. Size of ByteVector before operation.
+			/// @param site. Location of call to public entry point.
+			Probe(Operation operation, size_t capacity, size_t size, CallSite site)
+				: m_Operation{ operation }
+				, m_Site{ site }
+				, m_Capacity{ capacity }
+				, m_Size{ size }
+				, m_Active{ IsEnabled() && !Depth() && ++Depth() }
+			{
+			}
+
+			/// Finish measurement if Record was not called, e.g. because of exception.
+			~Probe()
+			{
+				if (m_Active)
+					--Depth();
+			}
+
+			Probe(Probe const&) = delete;
+			Probe& operator=(Probe const&) = delete;
+
+			/// Finish measurement.
+			/// @param capacity. Capacity of ByteVector after operation.
+			/// @param size. Size of ByteVector after operation.
+			void Record(size_t capacity, size_t size)
+			{
+				if (!m_Active)
+					return;
+
+				State().m_Counters[static_cast<size_t>(m_Operation)].Add(m_Capacity, m_Size, capacity, size);
+				if (auto site = FindSite(m_Site, m_Operation))
+					site->m_Counters.Add(m_Capacity, m_Size, capacity, size);
+
+				--Depth();
+				m_Active = false;
+			}
+
+		private:
+			/// Nesting level of probes on current thread.
+			static size_t& Depth()
+			{
+				thread_local size_t depth = 0;
+				return depth;
+			}
+
+			Operation m_Operation;
+			CallSite m_Site;
+			size_t m_Capacity;
+			size_t m_Size;
+			bool m_Active;
+		};
+
+	private:
+		/// Atomic version of Counters.
+		struct AtomicCounters
+		{
+			std::atomic<std::uint64_t> m_Calls{ 0 };
+			std::atomic<std::uint64_t> m_Allocations{ 0 };
+			std::atomic<std::uint64_t> m_Reallocations{ 0 };
+			std::atomic<std::uint64_t> m_BytesCopied{ 0 };
+			std::atomic<std::uint64_t> m_CapacitySlack{ 0 };
+
+			/// Account one call.
+			/// @param oldCapacity. Capacity of ByteVector before operation.
+			/// @param oldSize. Size of ByteVector before operation.
+			/// @param capacity. Capacity of ByteVector after operation.
+			/// @param size. Size of ByteVector after operation.
+			void Add(size_t oldCapacity, size_t oldSize, size_t capacity, size_t size)
+			{
+				m_Calls.fetch_add(1, std::memory_order_relaxed);
+				if (capacity != oldCapacity)
+				{
+					if (oldCapacity)
+					{
+						m_Reallocations.fetch_add(1, std::memory_order_relaxed);
+						m_BytesCopied.fetch_add(oldSize, std::memory_order_relaxed);
+					}
+					else
+					{
+						m_Allocations.fetch_add(1, std::memory_order_relaxed);
+					}
+				}
+
+				m_CapacitySlack.fetch_add(capacity - size, std::memory_order_relaxed);
+			}
+
+			/// Read current values.
+			Counters Load() const
+			{
+				auto ret = Counters{};
+				ret.m_Calls = m_Calls.load(std::memory_order_relaxed);
+				ret.m_Allocations = m_Allocations.load(std::memory_order_relaxed);
+				ret.m_Reallocations = m_Reallocations.load(std::memory_order_relaxed);
+				ret.m_BytesCopied = m_BytesCopied.load(std::memory_order_relaxed);
+				ret.m_CapacitySlack = m_CapacitySlack.load(std::memory_order_relaxed);
+				return ret;
+			}
+
+			/// Zero all values.
+			void Clear()
+			{
+				for (auto* counter : { &m_Calls, &m_Allocations, &m_Reallocations, &m_BytesCopied, &m_CapacitySlack })
+					counter->store(0, std::memory_order_relaxed);
+			}
+		};
+
+		/// State of slot of call site table.
+		enum class SiteState
+		{
+			empty,
+			claimed,
+			ready,
+		};
+
+		/// Counters of one operation called from one site.
+		/// Key is written once by thread that claimed empty slot, and published with SiteState::ready.
+		struct SiteSlot
+		{
+			std::atomic<SiteState> m_State{ SiteState::empty };
+			CallSite m_Site;
+			Operation m_Operation = Operation::write;
+			AtomicCounters m_Counters;
+		};
+
+		/// Maximal number of call sites.
+		static constexpr size_t MaxSites = BYTE_CONVERTER_ALLOCATION_SITES;
+
+		/// Global state shared by all translation units.
+		struct GlobalState
+		{
+			std::atomic<bool> m_Enabled{ false };
+			AtomicCounters m_Counters[3];
+			SiteSlot m_Sites[MaxSites];
+		};
+
+		/// Find slot of call site, registering it on first call.
+		/// Table is searched with linear probing. Slots are never released, so lookup does not take locks.
+		/// @param site. Location of call.
+		/// @param operation. Called operation.
+		/// @return slot, or nullptr if location is unknown or table is full.
+		static SiteSlot* FindSite(CallSite site, Operation operation)
+		{
+			if (!site.m_File)
+				return nullptr;
+
+			// Copies of the same file name in different translation units can have different addresses, so name is hashed by content.
+			auto file = std::string_view{ site.m_File };
+			auto hash = std::hash<std::string_view>{}(file) ^ (site.m_Line * size_t{ 31 } + static_cast<size_t>(operation));
+			for (auto i = size_t{ 0 }; i < MaxSites; ++i)
+			{
+				auto& slot = State().m_Sites[(hash + i) % MaxSites];
+				auto state = slot.m_State.load(std::memory_order_acquire);
+				if (state == SiteState::empty)
+				{
+					if (slot.m_State.compare_exchange_strong(state, SiteState::claimed, std::memory_order_acquire))
+					{
+						slot.m_Site = site;
+						slot.m_Operation = operation;
+						slot.m_State.store(SiteState::ready, std::memory_order_release);
+						return &slot;
+					}
+				}
+
+				// Key of claimed slot is about to be published.
+				while (state == SiteState::claimed)
+					state = slot.m_State.load(std::memory_order_acquire);
+
+				if (slot.m_Site.m_Line == site.m_Line && slot.m_Operation == operation && file == slot.m_Site.m_File)
+					return &slot;
+			}
+
+			return nullptr;
+		}
+
+		/// Get global state.
+		static GlobalState& State()
+		{
+			static GlobalState state;
+			return state;
+		}
+	};
+}
@@ -0,0 +1,805 @@
+#pragma once
+
+#include "ByteConverter.h"
+
+#if defined(__linux__)
+
+#include <cerrno>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace FSecure
+{
+	/// Mechanism used by FileSink and FileSource.
+	enum class AsyncFileBackend
+	{
+		/// Use io_uring if kernel supports it, otherwise threads.
+		automatic,
+
+		/// Submit requests to io_uring. Requires Linux 5.6.
+		uring,
+
+		/// Perform pwrite and pread on worker threads.
+		threads,
+	};
+
+	namespace Detail
+	{
+		/// Asynchronous write, or read of one buffer.
+		struct FileRequest
+		{
+			/// File descriptor.
+			int m_Descriptor = -1;
+
+			/// Write, or read.
+			bool m_Write = false;
+
+			/// Memory of buffer.
+			uint8_t* m_Data = nullptr;
+
+			/// Size of buffer.
+			size_t m_Size = 0;
+
+			/// Position in file.
+			uint64_t m_Offset = 0;
+
+			/// Number of transferred bytes, or negated errno. Valid after completion.
+			int64_t m_Result = 0;
+		};
+
+		/// Submission and completion queues of io_uring, accessed with raw system calls.
+		class UringQueue
+		{
+		public:
+			/// Set up io_uring.
+			/// @param entries. Size of submission queue.
+			/// @return queue, or nullptr if io_uring is not available, or does not support reads and writes.
+			static std::unique_ptr<UringQueue> Create(unsigned entries)
+			{
+				auto params = io_uring_params{};
+				auto descriptor = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+				if (descriptor < 0)
+					return nullptr;
+
+				auto ret = std::unique_ptr<UringQueue>{ new UringQueue{ descriptor, params } };
+				if (!ret->m_SqRing || !ret->m_CqRing || !ret->m_Sqes || !ret->SupportsRequests())
+					return nullptr;
+
+				return ret;
+			}
+
+			/// Unmap rings and close io_uring. All requests must be completed.
+			~UringQueue()
+			{
+				Unmap(m_SqRing, m_SqRingSize);
+				Unmap(m_CqRing, m_CqRingSize);
+				Unmap(m_Sqes, m_SqesSize);
+				close(m_Descriptor);
+			}
+
+			UringQueue(UringQueue const&) = delete;
+			UringQueue& operator=(UringQueue const&) = delete;
+
+			/// Queue request. Number of requests in flight must not exceed size of queue.
+			/// @param request. Request, that must live until it is returned by Complete.
+			void Submit(FileRequest& request)
+			{
+				auto tail = *m_SqTail;
+				auto index = tail & *m_SqMask;
+				auto& sqe = static_cast<io_uring_sqe*>(m_Sqes)[index];
+				sqe = io_uring_sqe{};
+				sqe.opcode = request.m_Write ? IORING_OP_WRITE : IORING_OP_READ;
+				sqe.fd = request.m_Descriptor;
+				sqe.off = request.m_Offset;
+				sqe.addr = reinterpret_cast<uint64_t>(request.m_Data);
+				sqe.len = static_cast<uint32_t>((std::min<size_t>)(request.m_Size, MaxTransfer));
+				sqe.user_data = reinterpret_cast<uint64_t>(&request);
+				m_SqArray[index] = index;
+				__atomic_store_n(m_SqTail, tail + 1, __ATOMIC_RELEASE);
+				++m_Unsubmitted;
+			}
+
+			/// Pass queued requests to kernel with single system call.
+			void Flush()
+			{
+				if (m_Unsubmitted)
+					Enter(0);
+			}
+
+			/// Get completed request. Queued requests are submitted only if waiting, so polling does not break batches.
+			/// @param wait. Block until request completes.
+			/// @return completed request, or nullptr if there is none and wait is false.
+			FileRequest* Complete(bool wait)
+			{
+				if (wait)
+					Flush();
+
+				while (true)
+				{
+					auto head = *m_CqHead;
+					if (head != __atomic_load_n(m_CqTail, __ATOMIC_ACQUIRE))
+					{
+						auto& cqe = m_Cqes[head & *m_CqMask];
+						auto request = reinterpret_cast<FileRequest*>(cqe.user_data);
+						request->m_Result = cqe.res;
+						__atomic_store_n(m_CqHead, head + 1, __ATOMIC_RELEASE);
+						return request;
+					}
+
+					if (!wait)
+						return nullptr;
+
+					Enter(1);
+				}
+			}
+
+		private:
+			/// Largest transfer of one request. Longer buffers are transferred partially, and resubmitted.
+			static constexpr size_t MaxTransfer = 1u << 30;
+
+			/// Map rings shared with kernel.
+			/// @param descriptor. io_uring descriptor.
+			/// @param params. Parameters filled by io_uring_setup.
+			UringQueue(int descriptor, io_uring_params const& params)
+				: m_Descriptor{ descriptor }
+				, m_SqRingSize{ params.sq_off.array + params.sq_entries * sizeof(unsigned) }
+				, m_CqRingSize{ params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe) }
+				, m_SqesSize{ params.sq_entries * sizeof(io_uring_sqe) }
+			{
+				m_SqRing = Map(m_SqRingSize, IORING_OFF_SQ_RING);
+				m_CqRing = Map(m_CqRingSize, IORING_OFF_CQ_RING);
+				m_Sqes = Map(m_SqesSize, IORING_OFF_SQES);
+				if (!m_SqRing || !m_CqRing || !m_Sqes)
+					return;
+
+				auto sq = static_cast<uint8_t*>(m_SqRing);
+				m_SqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+				m_SqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+				m_SqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+				auto cq = static_cast<uint8_t*>(m_CqRing);
+				m_CqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+				m_CqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+				m_CqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+				m_Cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+			}
+
+			/// Check if kernel supports operations used by requests.
+			/// io_uring_setup succeeds since Linux 5.1, but IORING_OP_READ and IORING_OP_WRITE were added in Linux 5.6, together with IORING_REGISTER_PROBE.
+			bool SupportsRequests() const
+			{
+				constexpr auto maxOperations = 256u;
+				auto memory = std::vector<uint8_t>(sizeof(io_uring_probe) + maxOperations * sizeof(io_uring_probe_op));
+				auto probe = reinterpret_cast<io_uring_probe*>(memory.data());
+				if (syscall(__NR_io_uring_register, m_Descriptor, IORING_REGISTER_PROBE, probe, maxOperations) < 0)
+					return false;
+
+				auto supported = [probe](unsigned operation) { return operation < probe->ops_len && (probe->ops[operation].flags & IO_URING_OP_SUPPORTED); };
+				return supported(IORING_OP_READ) && supported(IORING_OP_WRITE);
+			}
+
+			/// Map part of io_uring.
+			/// @param size. Size of mapping.
+			/// @param offset. Offset selecting ring.
+			/// @return mapped memory, or nullptr.
+			void* Map(size_t size, off_t offset)
+			{
+				auto ret = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_Descriptor, offset);
+				return ret == MAP_FAILED ? nullptr : ret;
+			}
+
+			/// Unmap part of io_uring.
+			/// @param memory. Mapped memory, or nullptr.
+			/// @param size. Size of mapping.
+			static void Unmap(void* memory, size_t size)
+			{
+				if (memory)
+					munmap(memory, size);
+			}
+
+			/// Submit queued requests, and wait for completions.
+			/// @param minComplete. Number of completions to wait for.
+			/// @throws std::system_error if io_uring_enter fails.
+			void Enter(unsigned minComplete)
+			{
+				auto submitted = syscall(__NR_io_uring_enter, m_Descriptor, m_Unsubmitted, minComplete, minComplete ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+				if (submitted < 0)
+				{
+					if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+						return;
+
+					BYTE_CONVERTER_THROW(std::system_error{ errno, std::system_category(), OBF("io_uring_enter") });
+				}
+
+				m_Unsubmitted -= static_cast<unsigned>(submitted);
+			}
+
+			/// io_uring descriptor.
+			int m_Descriptor;
+
+			/// Sizes of mappings.
+			size_t m_SqRingSize;
+			size_t m_CqRingSize;
+			size_t m_SqesSize;
+
+			/// Mappings.
+			void* m_SqRing = nullptr;
+			void* m_CqRing = nullptr;
+			void* m_Sqes = nullptr;
+
+			/// Fields of submission queue.
+			unsigned* m_SqTail = nullptr;
+			unsigned* m_SqMask = nullptr;
+			unsigned* m_SqArray = nullptr;
+
+			/// Fields of completion queue.
+			unsigned* m_CqHead = nullptr;
+			unsigned* m_CqTail = nullptr;
+			unsigned* m_CqMask = nullptr;
+			io_uring_cqe* m_Cqes = nullptr;
+
+			/// Number of queued requests not passed to kernel.
+			unsigned m_Unsubmitted = 0;
+		};
+
+		/// Worker threads performing pwrite and pread.
+		class ThreadQueue
+		{
+		public:
+			/// Start workers.
+			/// @param threads. Number of workers.
+			explicit ThreadQueue(size_t threads)
+			{
+				for (auto i = size_t{ 0 }; i < threads; ++i)
+					m_Workers.emplace_back([this] { Work(); });
+			}
+
+			/// Finish queued requests and stop workers.
+			~ThreadQueue()
+			{
+				{
+					auto lock = std::lock_guard{ m_Mutex };
+					m_Stop = true;
+				}
+
+				m_Submitted.notify_all();
+				for (auto& worker : m_Workers)
+					worker.join();
+			}
+
+			ThreadQueue(ThreadQueue const&) = delete;
+			ThreadQueue& operator=(ThreadQueue const&) = delete;
+
+			/// Queue request.
+			/// @param request. Request, that must live until it is returned by Complete.
+			void Submit(FileRequest& request)
+			{
+				m_Unsubmitted.push_back(&request);
+			}
+
+			/// Pass queued requests to workers.
+			void Flush()
+			{
+				if (m_Unsubmitted.empty())
+					return;
+
+				{
+					auto lock = std::lock_guard{ m_Mutex };
+					m_Queue.insert(m_Queue.end(), m_Unsubmitted.begin(), m_Unsubmitted.end());
+				}
+
+				m_Unsubmitted.clear();
+				m_Submitted.notify_all();
+			}
+
+			/// @see UringQueue::Complete.
+			FileRequest* Complete(bool wait)
+			{
+				if (wait)
+					Flush();
+
+				auto lock = std::unique_lock{ m_Mutex };
+				if (wait)
+					m_Finished.wait(lock, [this] { return !m_Completed.empty(); });
+
+				if (m_Completed.empty())
+					return nullptr;
+
+				auto ret = m_Completed.front();
+				m_Completed.pop_front();
+				return ret;
+			}
+
+		private:
+			/// Loop of worker.
+			void Work()
+			{
+				auto lock = std::unique_lock{ m_Mutex };
+				while (true)
+				{
+					m_Submitted.wait(lock, [this] { return m_Stop || !m_Queue.empty(); });
+					if (m_Queue.empty())
+						return;
+
+					auto request = m_Queue.front();
+					m_Queue.pop_front();
+					lock.unlock();
+					Perform(*request);
+					lock.lock();
+					m_Completed.push_back(request);
+					m_Finished.notify_one();
+				}
+			}
+
+			/// Transfer whole buffer.
+			/// @param request. Request to be performed.
+			static void Perform(FileRequest& request)
+			{
+				auto done = size_t{ 0 };
+				while (done < request.m_Size)
+				{
+					auto data = request.m_Data + done;
+					auto size = request.m_Size - done;
+					auto offset = static_cast<off_t>(request.m_Offset + done);
+					auto transferred = request.m_Write ? pwrite(request.m_Descriptor, data, size, offset) : pread(request.m_Descriptor, data, size, offset);
+					if (transferred < 0 && errno == EINTR)
+						continue;
+
+					if (transferred < 0)
+					{
+						request.m_Result = -errno;
+						return;
+					}
+
+					if (!transferred)
+						break;
+
+					done += static_cast<size_t>(transferred);
+				}
+
+				request.m_Result = static_cast<int64_t>(done);
+			}
+
+			/// Requests queued by Submit, but not passed to workers.
+			std::vector<FileRequest*> m_Unsubmitted;
+
+			/// Guards all members below.
+			std::mutex m_Mutex;
+			std::condition_variable m_Submitted;
+			std::condition_variable m_Finished;
+			std::deque<FileRequest*> m_Queue;
+			std::deque<FileRequest*> m_Completed;
+			bool m_Stop = false;
+
+			/// Worker threads.
+			std::vector<std::thread> m_Workers;
+		};
+
+		/// Queue of asynchronous requests, using io_uring or worker threads.
+		class FileQueue
+		{
+		public:
+			/// Create queue.
+			/// @param backend. Requested mechanism.
+			/// @param depth. Maximal number of requests in flight.
+			/// @throws std::system_error if io_uring was requested, but is not available.
+			FileQueue(AsyncFileBackend backend, size_t depth)
+			{
+				if (backend != AsyncFileBackend::threads)
+					m_Uring = UringQueue::Create(static_cast<unsigned>(depth));
+
+				if (backend == AsyncFileBackend::uring && !m_Uring)
+					BYTE_CONVERTER_THROW(std::system_error{ std::make_error_code(std::errc::function_not_supported), OBF("io_uring_setup") });
+
+				if (!m_Uring)
+					m_Threads = std::make_unique<ThreadQueue>(2);
+			}
+
+			/// Get used mechanism.
+			AsyncFileBackend Backend() const
+			{
+				return m_Uring ? AsyncFileBackend::uring : AsyncFileBackend::threads;
+			}
+
+			/// @see UringQueue::Submit.
+			void Submit(FileRequest& request)
+			{
+				m_Uring ? m_Uring->Submit(request) : m_Threads->Submit(request);
+			}
+
+			/// @see UringQueue::Flush.
+			void Flush()
+			{
+				m_Uring ? m_Uring->Flush() : m_Threads->Flush();
+			}
+
+			/// @see UringQueue::Complete.
+			FileRequest* Complete(bool wait)
+			{
+				return m_Uring ? m_Uring->Complete(wait) : m_Threads->Complete(wait);
+			}
+
+		private:
+			std::unique_ptr<UringQueue> m_Uring;
+			std::unique_ptr<ThreadQueue> m_Threads;
+		};
+	}
+
+	/// Appends buffers to file asynchronously, so serializing thread does not wait for write.
+	/// Written buffers are recycled, so steady stream of records does not allocate.
+	/// @code auto sink = FileSink{ descriptor }; sink.Write(record); sink.Flush(); @endcode
+	class FileSink
+	{
+	public:
+		/// Create sink.
+		/// @param descriptor. File opened for writing. Must outlive the sink.
+		/// @param offset. Position of the first write.
+		/// @param depth. Maximal number of writes in flight.
+		/// @param batch. Number of writes queued before they are submitted together.
+		/// @param backend. Mechanism of writing.
+		explicit FileSink(int descriptor, uint64_t offset = 0, size_t depth = 32, size_t batch = 8, AsyncFileBackend backend = AsyncFileBackend::automatic)
+			: m_Queue{ backend, depth }
+			, m_Descriptor{ descriptor }
+			, m_Offset{ offset }
+			, m_Batch{ (std::max)(batch, size_t{ 1 }) }
+			, m_Slots(depth)
+		{
+			for (auto& slot : m_Slots)
+				m_FreeSlots.push_back(&slot);
+		}
+
+		/// Wait for all writes. Errors are ignored, call Flush to detect them.
+		/// If waiting fails, error is latched and remaining writes are abandoned, because destructor must not throw.
+		~FileSink()
+		{
+			BYTE_CONVERTER_TRY
+			{
+				while (m_FreeSlots.size() < m_Slots.size())
+					Reap(true);
+			}
+			BYTE_CONVERTER_CATCH (...)
+			{
+				if (!m_Error)
+					m_Error = EIO;
+			}
+		}
+
+		FileSink(FileSink const&) = delete;
+		FileSink& operator=(FileSink const&) = delete;
+
+		/// Write raw content of buffer after previously written data, without header with size. Waits only if all slots are in flight.
+		/// Unlike Write, buffer is not serialized, so it is taken only as rvalue.
+		/// @param buffer. Data to be written. Returned by Recycle, when write is finished.
+		/// @throws std::system_error if one of previous writes failed.
+		void Submit(ByteVector&& buffer)
+		{
+			ThrowError();
+			if (buffer.empty())
+				return;
+
+			while (m_FreeSlots.empty())
+				Reap(true);
+
+			auto slot = m_FreeSlots.back();
+			m_FreeSlots.pop_back();
+			slot->m_Buffer = std::move(buffer);
+			slot->m_Descriptor = m_Descriptor;
+			slot->m_Write = true;
+			slot->m_Data = slot->m_Buffer.data();
+			slot->m_Size = slot->m_Buffer.size();
+			slot->m_Offset = m_Offset;
+			m_Offset += slot->m_Size;
+			Enqueue(*slot);
+		}
+
+		/// Serialize objects into recycled buffer, and write it.
+		/// Objects are framed the same way as by ByteVector::Write, whatever their type is, e.g. ByteView and ByteVector are preceded by size.
+		/// @param arg. Object to be stored.
+		/// @param args. Optional other objects to be stored.
+		/// @throws std::system_error if one of previous writes failed.
+		template <typename T, typename ...Ts>
+		void Write(T const& arg, Ts const& ...args)
+		{
+			auto buffer = Recycle();
+			buffer.Write(arg, args...);
+			Submit(std::move(buffer));
+		}
+
+		/// Get empty buffer with capacity of already written one, if there is any.
+		ByteVector Recycle()
+		{
+			while (Reap(false));
+			if (m_Recycled.empty())
+				return {};
+
+			auto ret = std::move(m_Recycled.back());
+			m_Recycled.pop_back();
+			return ret;
+		}
+
+		/// Submit queued writes, and wait until all of them are finished.
+		/// @throws std::system_error if one of writes failed.
+		void Flush()
+		{
+			m_Queue.Flush();
+			m_Unsubmitted = 0;
+			while (m_FreeSlots.size() < m_Slots.size())
+				Reap(true);
+
+			ThrowError();
+		}
+
+		/// Get position of next write.
+		uint64_t Offset() const
+		{
+			return m_Offset;
+		}
+
+		/// Get used mechanism.
+		AsyncFileBackend Backend() const
+		{
+			return m_Queue.Backend();
+		}
+
+	private:
+		/// Write in flight.
+		struct Slot : Detail::FileRequest
+		{
+			/// Written data.
+			ByteVector m_Buffer;
+		};
+
+		/// Queue request, and submit batch when it is full.
+		/// @param slot. Request to be queued.
+		void Enqueue(Slot& slot)
+		{
+			m_Queue.Submit(slot);
+			if (++m_Unsubmitted >= m_Batch)
+			{
+				m_Queue.Flush();
+				m_Unsubmitted = 0;
+			}
+		}
+
+		/// Handle one completed write.
+		/// @param wait. Block until write completes.
+		/// @return false if there was no completed write.
+		bool Reap(bool wait)
+		{
+			// Waiting Complete submits queued writes.
+			if (wait)
+				m_Unsubmitted = 0;
+
+			auto slot = static_cast<Slot*>(m_Queue.Complete(wait));
+			if (!slot)
+				return false;
+
+			auto written = static_cast<size_t>(slot->m_Result);
+			if (slot->m_Result > 0 && written < slot->m_Size)
+			{
+				// Short write. The rest is resubmitted.
+				slot->m_Data += written;
+				slot->m_Size -= written;
+				slot->m_Offset += written;
+				Enqueue(*slot);
+				return true;
+			}
+
+			if (slot->m_Result <= 0 && !m_Error)
+				m_Error = slot->m_Result ? static_cast<int>(-slot->m_Result) : EIO;
+
+			slot->m_Buffer.clear();
+			if (m_Recycled.size() < m_Slots.size())
+				m_Recycled.push_back(std::move(slot->m_Buffer));
+
+			m_FreeSlots.push_back(slot);
+			return true;
+		}
+
+		/// Throw error of previous write.
+		void ThrowError()
+		{
+			if (auto error = std::exchange(m_Error, 0))
+				BYTE_CONVERTER_THROW(std::system_error{ error, std::system_category(), OBF("FileSink") });
+		}
+
+		/// Queue of requests.
+		Detail::FileQueue m_Queue;
+
+		/// File descriptor.
+		int m_Descriptor;
+
+		/// Position of next write.
+		uint64_t m_Offset;
+
+		/// Number of writes submitted together.
+		size_t m_Batch;
+
+		/// Number of writes queued, but not submitted.
+		size_t m_Unsubmitted = 0;
+
+		/// Requests. Never resized, so addresses are stable.
+		std::vector<Slot> m_Slots;
+
+		/// Requests not in flight.
+		std::vector<Slot*> m_FreeSlots;
+
+		/// Buffers of finished writes.
+		std::vector<ByteVector> m_Recycled;
+
+		/// errno of first failed write.
+		int m_Error = 0;
+	};
+
+	/// Reads file sequentially, keeping blocks ahead of consumer in flight.
+	/// @code auto source = FileSource{ descriptor }; while (auto block = source.Next()) decoder.Feed(*block, consumer); @endcode
+	class FileSource
+	{
+	public:
+		/// Create source and start reading.
+		/// @param descriptor. File opened for reading. Must outlive the source.
+		/// @param offset. Position of the first block.
+		/// @param blockSize. Size of one read.
+		/// @param readAhead. Number of blocks in flight.
+		/// @param backend. Mechanism of reading.
+		explicit FileSource(int descriptor, uint64_t offset = 0, size_t blockSize = 64 * 1024, size_t readAhead = 4, AsyncFileBackend backend = AsyncFileBackend::automatic)
+			: m_Queue{ backend, (std::max)(readAhead, size_t{ 1 }) }
+			, m_Descriptor{ descriptor }
+			, m_Offset{ offset }
+			, m_Slots((std::max)(readAhead, size_t{ 1 }))
+		{
+			for (auto& slot : m_Slots)
+			{
+				slot.m_Buffer.resize(blockSize);
+				Issue(slot);
+			}
+
+			m_Queue.Flush();
+		}
+
+		/// Wait for reads in flight.
+		~FileSource()
+		{
+			for (auto& slot : m_Slots)
+				while (slot.m_Issued && !slot.m_Done)
+					Reap();
+		}
+
+		FileSource(FileSource const&) = delete;
+		FileSource& operator=(FileSource const&) = delete;
+
+		/// Get next block of file. Block stays valid until following call.
+		/// Short reads are resubmitted, so only the last block is shorter than blockSize.
+		/// @return view of block, or empty std::optional at the end of file.
+		/// @throws std::system_error if read failed.
+		std::optional<ByteView> Next()
+		{
+			if (m_Returned)
+			{
+				// Consumer is done with previous block, so its buffer is reused for the next read.
+				m_Returned = false;
+				if (!m_End)
+				{
+					Issue(m_Slots[m_Front]);
+					m_Queue.Flush();
+				}
+
+				m_Front = (m_Front + 1) % m_Slots.size();
+			}
+
+			auto& slot = m_Slots[m_Front];
+			if (!slot.m_Issued)
+				return {};
+
+			while (!slot.m_Done)
+				Reap();
+
+			slot.m_Issued = false;
+			if (slot.m_Result < 0)
+			{
+				m_End = true;
+				BYTE_CONVERTER_THROW(std::system_error{ static_cast<int>(-slot.m_Result), std::system_category(), OBF("FileSource") });
+			}
+
+			auto size = slot.m_Length;
+			if (size < slot.m_Buffer.size())
+				m_End = true;
+
+			if (!size)
+				return {};
+
+			m_Returned = true;
+			return ByteView{ slot.m_Buffer.data(), size };
+		}
+
+		/// Get used mechanism.
+		AsyncFileBackend Backend() const
+		{
+			return m_Queue.Backend();
+		}
+
+	private:
+		/// Read in flight.
+		struct Slot : Detail::FileRequest
+		{
+			/// Memory of block.
+			ByteVector m_Buffer;
+
+			/// Read was submitted.
+			bool m_Issued = false;
+
+			/// Read was completed.
+			bool m_Done = false;
+
+			/// Number of bytes read into block.
+			size_t m_Length = 0;
+		};
+
+		/// Submit read of next block.
+		/// @param slot. Request to be submitted.
+		void Issue(Slot& slot)
+		{
+			slot.m_Descriptor = m_Descriptor;
+			slot.m_Data = slot.m_Buffer.data();
+			slot.m_Size = slot.m_Buffer.size();
+			slot.m_Offset = m_Offset;
+			slot.m_Issued = true;
+			slot.m_Done = false;
+			slot.m_Length = 0;
+			m_Offset += slot.m_Size;
+			m_Queue.Submit(slot);
+		}
+
+		/// Wait for one completed read.
+		void Reap()
+		{
+			auto slot = static_cast<Slot*>(m_Queue.Complete(true));
+			auto read = static_cast<size_t>(slot->m_Result);
+			if (slot->m_Result > 0)
+				slot->m_Length += read;
+
+			if (slot->m_Result > 0 && read < slot->m_Size)
+			{
+				// Short read, e.g. limited by size of transfer. The rest is resubmitted, only read of zero bytes is the end of file.
+				slot->m_Data += read;
+				slot->m_Size -= read;
+				slot->m_Offset += read;
+				m_Queue.Submit(*slot);
+				m_Queue.Flush();
+				return;
+			}
+
+			slot->m_Done = true;
+		}
+
+		/// Queue of requests.
+		Detail::FileQueue m_Queue;
+
+		/// File descriptor.
+		int m_Descriptor;
+
+		/// Position of next read.
+		uint64_t m_Offset;
+
+		/// Requests. Never resized, so addresses are stable.
+		std::vector<Slot> m_Slots;
+
+		/// Index of slot with next block.
+		size_t m_Front = 0;
+
+		/// Block of front slot was returned to consumer.
+		bool m_Returned = false;
+
+		/// The end of file, or error was reached.
+		bool m_End = false;
+	};
+}
+
+#endif
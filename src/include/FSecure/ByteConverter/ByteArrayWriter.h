@@ -0,0 +1,218 @@
+#pragma once
+
+#include "ByteSpan.h"
+
+/// __builtin_bit_cast allows constexpr access to representation of floating point types.
+#if defined(__has_builtin)
+#	if __has_builtin(__builtin_bit_cast)
+#		define BYTE_CONVERTER_HAS_BIT_CAST 1
+#	endif
+#endif
+#if !defined(BYTE_CONVERTER_HAS_BIT_CAST) && defined(_MSC_VER) && _MSC_VER >= 1927
+#	define BYTE_CONVERTER_HAS_BIT_CAST 1
+#endif
+
+namespace FSecure
+{
+	namespace Detail
+	{
+		/// True if the most significant byte of arithmetic types is stored first.
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		constexpr bool IsBigEndian = true;
+#else
+		constexpr bool IsBigEndian = false;
+#endif
+
+		/// Unsigned integer with the same size as T.
+		template <size_t Size>
+		struct UnsignedOfSize;
+
+		template <> struct UnsignedOfSize<1> { using type = uint8_t; };
+		template <> struct UnsignedOfSize<2> { using type = uint16_t; };
+		template <> struct UnsignedOfSize<4> { using type = uint32_t; };
+		template <> struct UnsignedOfSize<8> { using type = uint64_t; };
+
+		/// Checks if ByteConverter can serialize directly into Writer.
+		/// Built-in converters define To as constexpr template over output type, so they are evaluated at compile time.
+		template <typename T, typename Writer, typename = void>
+		struct ExpandWriterCondition : std::false_type {};
+
+		template <typename T, typename Writer>
+		struct ExpandWriterCondition<T, Writer, decltype(void(ByteConverter<T>::To(std::declval<T>(), std::declval<Writer&>())))> : std::true_type {};
+	}
+
+	/// Writer serializing at compile time into ByteArray.
+	/// Objects are serialized by To of their ByteConverter, with writer used as output, the same way as ByteSpan.
+	/// Conversion is constexpr for arithmetic types, enums, std::array, tuples, variants, and types with TupleConverter or AggregateConverter,
+	/// whose Convert is constexpr. Custom converters defining constexpr To(obj, Output&) are supported as well.
+	/// Converters taking only ByteVector are serialized at runtime, without allocations.
+	/// @code static constexpr auto hello = ToByteArray(uint32_t{ 1 }, Command::hello); @endcode
+	/// @tparam N. Capacity of ByteArray.
+	template <size_t N>
+	class ByteArrayWriter
+	{
+	public:
+		/// Type of stored values.
+		using ValueType = std::uint8_t;
+
+		/// Objects are stored one by one, because memory cannot be copied at compile time.
+		static constexpr bool StoresElementwise = true;
+
+		/// Write arguments after already written data.
+		/// @param args. Objects to be serialized.
+		/// @return itself to allow chaining.
+		/// @throws std::out_of_range if capacity is exceeded.
+		template <typename ...Ts>
+		constexpr ByteArrayWriter& Write(Ts const& ...args)
+		{
+			return Store(args...);
+		}
+
+		/// Store arguments after already written data. Used by To of converters.
+		/// @param args. Objects to be serialized.
+		/// @return itself to allow chaining.
+		/// @throws std::out_of_range if capacity is exceeded.
+		template <typename ...Ts>
+		constexpr ByteArrayWriter& Store(Ts const& ...args)
+		{
+			(StoreOne(args), ...);
+			return *this;
+		}
+
+		/// Copy bytes of arguments after already written data.
+		/// @param args. Containers of bytes.
+		/// @return itself to allow chaining.
+		/// @throws std::out_of_range if capacity is exceeded.
+		template <typename ...Ts>
+		constexpr ByteArrayWriter& Concat(Ts const& ...args)
+		{
+			auto copy = [this](auto const& arg)
+			{
+				auto position = m_Position;
+				resize(position + arg.size());
+				for (auto i = size_t{ 0 }; i < arg.size(); ++i)
+					m_Array[position + i] = static_cast<std::uint8_t>(arg[i]);
+			};
+
+			(copy(args), ...);
+			return *this;
+		}
+
+		/// Change number of written bytes. New bytes are zeroed.
+		/// @param newSize. Number of written bytes.
+		/// @throws std::out_of_range if capacity is exceeded.
+		constexpr void resize(size_t newSize)
+		{
+			if (newSize > N)
+				BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Cannot write data to ByteArray") });
+
+			for (auto i = m_Position; i < newSize; ++i)
+				m_Array[i] = 0;
+
+			m_Position = newSize;
+		}
+
+		/// Get pointer to serialized data.
+		constexpr std::uint8_t* data()
+		{
+			return m_Array.data();
+		}
+
+		/// Get pointer to serialized data.
+		constexpr std::uint8_t const* data() const
+		{
+			return m_Array.data();
+		}
+
+		/// Get number of written bytes.
+		constexpr size_t size() const
+		{
+			return m_Position;
+		}
+
+		/// Get capacity of ByteArray.
+		constexpr size_t capacity() const
+		{
+			return N;
+		}
+
+		/// Get serialized data.
+		constexpr ByteArray<N> const& Get() const
+		{
+			return m_Array;
+		}
+
+	private:
+		/// Store one object.
+		/// @param arg. Object to be serialized.
+		template <typename T>
+		constexpr void StoreOne(T const& arg)
+		{
+			// Representation in memory cannot be read at compile time, so arithmetic types are written byte by byte.
+			if constexpr (std::is_same_v<T, bool>)
+				WriteUnsigned(static_cast<uint8_t>(arg));
+			else if constexpr (std::is_integral_v<T>)
+				WriteUnsigned(static_cast<std::make_unsigned_t<T>>(arg));
+			else if constexpr (std::is_floating_point_v<T>)
+			{
+#if defined(BYTE_CONVERTER_HAS_BIT_CAST)
+				WriteUnsigned(__builtin_bit_cast(typename Detail::UnsignedOfSize<sizeof(T)>::type, arg));
+#else
+				static_assert(!std::is_floating_point_v<T>, "Floating point types require __builtin_bit_cast");
+#endif
+			}
+			else if constexpr (Detail::ExpandWriterCondition<T, ByteArrayWriter>::value)
+				ByteConverter<T>::To(arg, *this);
+			else // Converter takes only ByteVector, serialize in place at runtime.
+				m_Position += ByteSpan{ m_Array.data() + m_Position, N - m_Position }.Write(arg).size();
+		}
+
+		/// Write bytes of unsigned integer in order of memory representation.
+		/// @param value. Integer to be serialized.
+		template <typename U>
+		constexpr void WriteUnsigned(U value)
+		{
+			if (m_Position + sizeof(U) > N)
+				BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Cannot write data to ByteArray") });
+
+			for (auto i = size_t{ 0 }; i < sizeof(U); ++i)
+			{
+				auto shift = 8 * (Detail::IsBigEndian ? sizeof(U) - 1 - i : i);
+				m_Array[m_Position++] = static_cast<uint8_t>((value >> shift) & 0xFF);
+			}
+		}
+
+		/// Serialized data.
+		ByteArray<N> m_Array{};
+
+		/// Number of written bytes.
+		size_t m_Position = 0;
+	};
+
+	/// Serialize objects with Size known at compile time into ByteArray.
+	/// Can be evaluated at compile time, placing result in read only data of binary.
+	/// @param args. Objects to be serialized.
+	/// @return ByteArray with the same content as ByteVector::Create(args...).
+	template <typename ...Ts>
+	constexpr auto ToByteArray(Ts const& ...args)
+	{
+		static_assert(((Detail::ConverterDeduction<Ts>::FunctionSize::value == Detail::SizeFunction::compileTime) && ...),
+			"ByteConverter<T>::Size() must be known at compile time for all types");
+
+		return ByteArrayWriter<(size_t{ 0 } + ... + ByteConverter<Ts>::Size())>{}.Write(args...).Get();
+	}
+
+	/// Deserialize objects from ByteArray created by ToByteArray.
+	/// Size of array must be equal to sum of sizes of types.
+	/// @param array. Serialized data.
+	/// @return object of type T, or tuple of objects if more types were provided.
+	template <typename T, typename ...Ts, size_t N>
+	auto FromByteArray(ByteArray<N> const& array)
+	{
+		static_assert(((Detail::ConverterDeduction<T>::FunctionSize::value == Detail::SizeFunction::compileTime) && ... && (Detail::ConverterDeduction<Ts>::FunctionSize::value == Detail::SizeFunction::compileTime)),
+			"ByteConverter<T>::Size() must be known at compile time for all types");
+		static_assert((ByteConverter<T>::Size() + ... + ByteConverter<Ts>::Size()) == N, "Size of ByteArray does not match serialized types");
+
+		return ByteView{ array }.Read<T, Ts...>();
+	}
+}
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
+#include <optional>
 #include <variant>
 
 #include "ByteView.h"
+#include "Reflection.h"
 
 /// specializations for ByteConverter for common types.
 namespace FSecure
@@ -12,10 +15,14 @@ namespace FSecure
 	template <typename T>
 	struct ByteConverter<T, std::enable_if_t<std::is_arithmetic_v<T>>>
 	{
+		/// Serialized form is identical to object representation in memory.
+		static constexpr bool TriviallySerializable = true;
+
 		/// Serialize arithmetic type to ByteVector.
 		/// @param obj. Object to be serialized.
-		/// @param bv. ByteVector to be expanded.
-		static void To(T obj, ByteVector& bv)
+		/// @param bv. ByteVector, or ByteSpan to be expanded.
+		template <typename Output>
+		static void To(T obj, Output& bv)
 		{
 			auto oldSize = bv.size();
 			bv.resize(oldSize + Size());
@@ -48,10 +55,14 @@ namespace FSecure
 	template <typename T>
 	struct ByteConverter<T, std::enable_if_t<std::is_enum_v<T>>>
 	{
+		/// Serialized form is identical to object representation in memory.
+		static constexpr bool TriviallySerializable = true;
+
 		/// Serialize enum type to ByteVector.
 		/// @param enumInstance. Object to be serialized.
-		/// @param bv. ByteVector to be expanded.
-		static void To(T enumInstance, ByteVector& bv)
+		/// @param bv. ByteVector, or ByteSpan to be expanded.
+		template <typename Output>
+		static constexpr void To(T enumInstance, Output& bv)
 		{
 			bv.Store(static_cast<std::underlying_type_t<T>>(enumInstance));
 		}
@@ -72,27 +83,216 @@ namespace FSecure
 		}
 	};
 
+	namespace Detail
+	{
+		/// Checks if serialized form of type is identical to its object representation in memory.
+		/// Such types, and contiguous sequences of them, can be serialized with one memcpy.
+		/// ByteConverter opts in by defining static constexpr bool TriviallySerializable = true.
+		template <typename T, typename = void>
+		struct TriviallySerializable : std::false_type {};
+
+		template <typename T>
+		struct TriviallySerializable<T, std::enable_if_t<ByteConverter<T>::TriviallySerializable>> : std::true_type {};
+
+		/// Checks if output requires objects to be stored one by one, instead of copying their memory.
+		/// Outputs usable at compile time opt in by defining static constexpr bool StoresElementwise = true.
+		template <typename Output, typename = void>
+		struct StoresElementwise : std::false_type {};
+
+		template <typename Output>
+		struct StoresElementwise<Output, std::enable_if_t<Output::StoresElementwise>> : std::true_type {};
+
+		/// Describes types that may hold no value.
+		/// Specializations define stored Value, Make creating type holding value,
+		/// and reusable flag telling if held value can be overwritten in place during deserialization.
+		/// Presence is tested with explicit cast to bool, value is accessed with operator*, and removed with reset().
+		template <typename T, typename = void>
+		struct Nullable : std::false_type {};
+
+		template <typename T>
+		struct Nullable<std::optional<T>> : std::true_type
+		{
+			using Value = T;
+			static constexpr bool reusable = true;
+			static std::optional<T> Make(Value&& value) { return { std::move(value) }; }
+		};
+
+		template <typename T>
+		struct Nullable<std::unique_ptr<T>, std::enable_if_t<!std::is_array_v<T>>> : std::true_type
+		{
+			using Value = std::remove_const_t<T>;
+			static constexpr bool reusable = !std::is_const_v<T>;
+			static std::unique_ptr<T> Make(Value&& value) { return std::make_unique<Value>(std::move(value)); }
+		};
+
+		/// Objects held by std::shared_ptr may be observed by other owners, so they are never overwritten.
+		template <typename T>
+		struct Nullable<std::shared_ptr<T>, std::enable_if_t<!std::is_array_v<T>>> : std::true_type
+		{
+			using Value = std::remove_const_t<T>;
+			static constexpr bool reusable = false;
+			static std::shared_ptr<T> Make(Value&& value) { return std::make_shared<Value>(std::move(value)); }
+		};
+
+		/// Read value of nullable object, whose presence is already known.
+		/// @param bv. Buffer with serialized data.
+		/// @param obj. Object to be overwritten.
+		/// @param present. True if value was serialized.
+		template <typename T>
+		void ReadNullableInto(ByteView& bv, T& obj, bool present)
+		{
+			if (!present)
+				obj.reset();
+			else if constexpr (Nullable<T>::reusable)
+				obj ? static_cast<void>(bv.ReadInto(*obj)) : static_cast<void>(obj = Nullable<T>::Make(bv.Read<typename Nullable<T>::Value>()));
+			else
+				obj = Nullable<T>::Make(bv.Read<typename Nullable<T>::Value>());
+		}
+	}
+
+	/// ByteConverter specialization for std::optional, std::unique_ptr and std::shared_ptr.
+	/// One byte marker of presence precedes value. Empty objects are serialized as marker only.
+	template <typename T>
+	struct ByteConverter<T, std::enable_if_t<Detail::Nullable<T>::value>>
+	{
+		/// Serialize nullable type to ByteVector.
+		/// @param obj. Object to be serialized.
+		/// @param bv. ByteVector, or ByteSpan to be expanded.
+		template <typename Output>
+		static void To(T const& obj, Output& bv)
+		{
+			bv.Store(static_cast<uint8_t>(static_cast<bool>(obj)));
+			if (obj)
+				bv.Store(*obj);
+		}
+
+		/// Get size required after serialization.
+		/// @param obj. Instance for which size should be found.
+		/// @return size_t. Number of bytes used after serialization.
+		static size_t Size(T const& obj)
+		{
+			return sizeof(uint8_t) + (obj ? ByteVector::Size(*obj) : 0);
+		}
+
+		/// Deserialize from ByteView.
+		/// @param bv. Buffer with serialized data.
+		/// @return nullable type.
+		static T From(ByteView& bv)
+		{
+			if (!bv.Read<uint8_t>())
+				return T{};
+
+			return Detail::Nullable<T>::Make(bv.Read<typename Detail::Nullable<T>::Value>());
+		}
+
+		/// Deserialize from ByteView into existing object, overwriting held value in place when possible.
+		/// @param bv. Buffer with serialized data.
+		/// @param obj. Object to be overwritten.
+		static void From(ByteView& bv, T& obj)
+		{
+			Detail::ReadNullableInto(bv, obj, bv.Read<uint8_t>());
+		}
+
+		/// Skip serialized object without constructing it.
+		/// @param bv. Buffer with serialized data.
+		static void Skip(ByteView& bv)
+		{
+			if (bv.Read<uint8_t>())
+				bv.Skip<typename Detail::Nullable<T>::Value>();
+		}
+	};
+
 	/// ByteConverter specialization for iterable types.
 	template <typename T>
 	struct ByteConverter<T, std::enable_if_t<Utils::Container::IsIterable<T>::value>>
 	{
+	private:
+		/// Check if container maps keys to values.
+		template <typename C, typename = void>
+		struct IsMap : std::false_type {};
+
+		template <typename C>
+		struct IsMap<C, std::void_t<typename C::mapped_type>> : std::true_type {};
+
+		/// Way in which existing container is reused during deserialization.
+		enum class Reuse
+		{
+			none,
+			memory,
+			elements,
+			nodes,
+		};
+
+		/// Check if size of container of type C is known at compile time.
+		template <typename C>
+		static constexpr bool IsSizeConstexpr()
+		{
+			using Deduction = typename Detail::ConverterDeduction<Utils::Container::StoredValue<C>>::FunctionSize;
+			return Utils::Container::IsArray<C>::value && Deduction::value == Deduction::type::compileTime;
+		}
+
+		/// Choose way of reusing container of type C.
+		template <typename C>
+		static constexpr Reuse ReuseOf()
+		{
+			using namespace Utils::Container;
+			using Element = StoredValue<C>;
+			if constexpr (HasExtract<C>::value)
+				return Reuse::nodes;
+			else if constexpr (!std::is_same_v<decltype(*begin(std::declval<C&>())), Element&>)
+				return Reuse::none; // e.g. std::vector<bool>, or views
+			else if constexpr (HasResize<C>::value && IsContiguous<C>::value && Detail::TriviallySerializable<Element>::value)
+				return Reuse::memory;
+			else if constexpr ((HasResize<C>::value && std::is_default_constructible_v<Element>) || IsArray<C>::value)
+				return Reuse::elements;
+			else
+				return Reuse::none;
+		}
+
+	public:
 		/// Serialize iterable type to ByteVector.
 		/// @param obj. Object to be serialized.
-		/// @param bv. ByteVector to be expanded.
-		static void To(T const& obj, ByteVector& bv)
+		/// @param bv. ByteVector, or ByteSpan to be expanded.
+		template <typename Output>
+		static constexpr void To(T const& obj, Output& bv)
 		{
-			if (auto numberOfElements = Utils::Container::Size{}(obj); numberOfElements <= std::numeric_limits<uint32_t>::max())
-				bv.Write(static_cast<uint32_t>(numberOfElements));
+			using Element = Utils::Container::StoredValue<T>;
+			auto numberOfElements = Utils::Container::Size{}(obj);
+			if (numberOfElements <= std::numeric_limits<uint32_t>::max())
+				bv.Store(static_cast<uint32_t>(numberOfElements));
 			else
 				BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Cannot write size to ByteVector ") });
 
-			for (auto&& e : obj)
-				bv.Write(e);
+			if constexpr (Utils::Container::IsContiguous<T>::value && Detail::TriviallySerializable<Element>::value && !Detail::StoresElementwise<Output>::value)
+			{
+				// Elements are stored exactly as they are laid out in memory.
+				auto oldSize = bv.size();
+				bv.resize(oldSize + numberOfElements * sizeof(Element));
+				if (numberOfElements) // data() of empty container can be null, which memcpy does not accept.
+					memcpy(bv.data() + oldSize, obj.data(), numberOfElements * sizeof(Element));
+			}
+			else
+			{
+				// Capacity was reserved by outermost Write, so elements are not measured again.
+				for (auto&& e : obj)
+					bv.Store(e);
+			}
+		}
+
+		/// Get size required after serialization of std::array, whose elements have size known at compile time.
+		/// @note All template parameters are used only to determine if function should be defined.
+		/// @return size_t. Number of bytes used after serialization.
+		template <typename C = T>
+		static constexpr auto Size() -> std::enable_if_t<IsSizeConstexpr<C>(), size_t>
+		{
+			return sizeof(uint32_t) + std::tuple_size_v<T> * ByteConverter<Utils::Container::StoredValue<T>>::Size();
 		}
 
 		/// Get size required after serialization.
+		/// @note All template parameters are used only to determine if function should be defined.
 		/// @return size_t. Number of bytes used after serialization.
-		static size_t Size(T const& obj)
+		template <typename C = T>
+		static auto Size(T const& obj) -> std::enable_if_t<!IsSizeConstexpr<C>(), size_t>
 		{
 			using Element = Utils::Container::StoredValue<T>;
 			using Deduction = typename Detail::ConverterDeduction<Element>::FunctionSize;
@@ -120,7 +320,13 @@ namespace FSecure
 			if (sizeof(uint32_t) > bv.size())
 				BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Cannot read size from ByteView ") });
 
-			if constexpr (Signature::value == Signature::type::queued)
+			if constexpr (ReuseOf<T>() == Reuse::memory || (Utils::Container::IsArray<T>::value && Detail::TriviallySerializable<Element>::value))
+			{
+				auto ret = Utils::Container::Construct<T>();
+				From(bv, ret);
+				return ret;
+			}
+			else if constexpr (Signature::value == Signature::type::queued)
 			{
 				return Generator{}(bv.Read<uint32_t>(), [&bv] { return bv.Read<Element>(); } );
 			}
@@ -135,6 +341,120 @@ namespace FSecure
 
 			static_assert(Signature::value != Signature::type::unknown, "Unable to find container generator for provided type");
 		}
+
+		/// Deserialize from ByteView into existing container, reusing its memory.
+		/// Contiguous and resizable containers keep their capacity and elements are overwritten in place.
+		/// Node based containers extract their nodes and reinsert them with new values.
+		/// @param bv. Buffer with serialized data.
+		/// @param obj. Container to be overwritten.
+		template <typename C = T>
+		static auto From(ByteView& bv, T& obj) -> std::enable_if_t<ReuseOf<C>() != Reuse::none>
+		{
+			using Element = Utils::Container::StoredValue<T>;
+			using Deduction = typename Detail::ConverterDeduction<Element>::FunctionSize;
+
+			auto size = bv.Read<uint32_t>();
+			if constexpr (Deduction::value == Deduction::type::compileTime)
+				if (static_cast<uint64_t>(size) * ByteConverter<Element>::Size() > bv.size())
+					BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Cannot read data from ByteView") });
+
+			if constexpr (ReuseOf<C>() == Reuse::memory)
+			{
+				obj.resize(size);
+				if (size)
+					memcpy(obj.data(), bv.data(), size * sizeof(Element));
+
+				bv.remove_prefix(size * sizeof(Element));
+			}
+			else if constexpr (ReuseOf<C>() == Reuse::elements)
+			{
+				if constexpr (Utils::Container::IsArray<T>::value)
+				{
+					if (size != std::tuple_size_v<T>)
+						BYTE_CONVERTER_THROW(std::runtime_error{ OBF("Array size does not match declaration") });
+				}
+				else
+				{
+					obj.resize(size);
+				}
+
+				if constexpr (Utils::Container::IsArray<T>::value && Detail::TriviallySerializable<Element>::value)
+				{
+					if (size)
+						memcpy(obj.data(), bv.data(), size * sizeof(Element));
+
+					bv.remove_prefix(size * sizeof(Element));
+				}
+				else
+				{
+					for (auto& e : obj)
+						bv.ReadInto(e);
+				}
+			}
+			else if constexpr (ReuseOf<C>() == Reuse::nodes)
+			{
+				// Spare nodes are kept on thread local stack. Nested containers of the same type push their nodes above base.
+				thread_local std::vector<typename T::node_type> cache;
+				auto base = cache.size();
+				while (!obj.empty())
+					cache.push_back(obj.extract(obj.begin()));
+
+				BYTE_CONVERTER_TRY
+				{
+					if constexpr (Utils::Container::HasReserve<T>::value)
+						obj.reserve(size);
+
+					for (auto i = 0u; i < size; ++i)
+					{
+						if (cache.size() == base)
+						{
+							obj.insert(obj.end(), bv.Read<Element>());
+							continue;
+						}
+
+						auto node = std::move(cache.back());
+						cache.pop_back();
+						if constexpr (IsMap<T>::value)
+							bv.ReadInto(node.key(), node.mapped());
+						else
+							bv.ReadInto(node.value());
+
+						obj.insert(obj.end(), std::move(node));
+					}
+
+					cache.erase(cache.begin() + base, cache.end());
+				}
+				BYTE_CONVERTER_CATCH(...)
+				{
+					cache.erase(cache.begin() + base, cache.end());
+					BYTE_CONVERTER_THROW();
+				}
+			}
+		}
+
+		/// Skip serialized container without constructing it.
+		/// Elements with size known at compile time are skipped all at once.
+		/// @param bv. Buffer with serialized data.
+		static void Skip(ByteView& bv)
+		{
+			using Element = Utils::Container::StoredValue<T>;
+			using Deduction = typename Detail::ConverterDeduction<Element>::FunctionSize;
+
+			auto size = bv.Read<uint32_t>();
+			if constexpr (Deduction::value == Deduction::type::compileTime)
+			{
+				auto bytes = static_cast<uint64_t>(size) * ByteConverter<Element>::Size();
+				if (bytes > bv.size())
+					BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Cannot read data from ByteView") });
+
+				bv.remove_prefix(static_cast<size_t>(bytes));
+			}
+			else
+			{
+				for (auto i = 0u; i < size; ++i)
+					bv.Skip<Element>();
+			}
+		}
 	};
 
 	/// ByteConverter specialization for std::filesystem::path.
@@ -143,8 +463,9 @@ namespace FSecure
 	{
 		/// Serialize path type to ByteVector.
 		/// @param pathInstance. Object to be serialized.
-		/// @param bv. ByteVector to be expanded.
-		static void To(std::filesystem::path const& pathInstance, ByteVector& bv)
+		/// @param bv. ByteVector, or ByteSpan to be expanded.
+		template <typename Output>
+		static void To(std::filesystem::path const& pathInstance, Output& bv)
 		{
 			bv.Store(pathInstance.wstring());
 		}
@@ -178,39 +499,88 @@ namespace FSecure
 		using ConstSize = std::integral_constant<size_t, size>;
 
 		/// @brief Calls provided function with dynamic index transformed into integral constant.
-		/// Using Index template will generate series of functions, from Idx to MaxIdx,
-		/// that will recursively call next one, until dynamic index matches static one.
-		/// @tparam Idx static index.
+		/// Dispatch is performed through table of functions, one for each alternative.
 		/// @param idx dynamic index.
 		/// @param func function that will perform actual logic with matched index.
-		/// @throws std::runtime_error if dynamic index is greater than MaxIdx.
-		template<size_t Idx = 0, typename Func>
-		static auto Index([[maybe_unused]] size_t idx, Func&& func) -> decltype(func(ConstSize<0>{}))
+		/// @throws std::runtime_error if dynamic index is out of variant bounds.
+		template<typename Func>
+		static auto Index(size_t idx, Func&& func) -> decltype(func(ConstSize<0>{}))
 		{
-			if constexpr (Idx < std::variant_size_v<VarT>)
-				return idx == Idx ? func(ConstSize<Idx>{}) : Index<Idx + 1>(idx, std::forward<Func>(func));
-			else
+			return IndexImpl(idx, func, std::make_index_sequence<std::variant_size_v<VarT>>{});
+		}
+
+		/// @brief Implementation of Index.
+		/// @tparam Is indices of all alternatives.
+		template<typename Func, size_t ...Is>
+		static auto IndexImpl(size_t idx, Func& func, std::index_sequence<Is...>) -> decltype(func(ConstSize<0>{}))
+		{
+			using Result = decltype(func(ConstSize<0>{}));
+			constexpr Result(*table[])(Func&) = { [](Func& f) -> Result { return f(ConstSize<Is>{}); }... };
+			if (idx >= sizeof...(Is))
 				BYTE_CONVERTER_THROW(std::runtime_error{ OBF("Index out of bounds") });
+
+			return table[idx](func);
+		}
+
+		/// @brief Check if all alternatives have Size that can be determined at compilation time.
+		/// @note Template parameter is used only to postpone evaluation until ByteConverter of all alternatives are defined.
+		template <typename C>
+		static constexpr bool IsSizeConstexpr()
+		{
+			return ((Detail::ConverterDeduction<Ts>::FunctionSize::value == Detail::SizeFunction::compileTime) && ...);
+		}
+
+		/// @brief Check if all alternatives have the same Size known at compilation time.
+		/// @note Template parameter is used only to postpone evaluation until ByteConverter of all alternatives are defined.
+		template <typename C>
+		static constexpr bool IsSizeFixed()
+		{
+			if constexpr (IsSizeConstexpr<C>())
+				return ((ByteConverter<Ts>::Size() == ByteConverter<std::variant_alternative_t<0, C>>::Size()) && ...);
+			else
+				return false;
 		}
 
 	public:
 		/// Serialize variant type to ByteVector.
 		/// @param var. Object to be serialized.
-		/// @param bv. ByteVector to be expanded.
-		static void To(VarT const& var, ByteVector& bv)
+		/// @param bv. ByteVector, or ByteSpan to be expanded.
+		template <typename Output>
+		static constexpr void To(VarT const& var, Output& bv)
 		{
 			bv.Store(var.index());
-			bv.Concat(std::visit([](auto&& arg) { return ByteVector::Create(arg); }, var));
+			std::visit([&bv](auto const& arg) { bv.Store(arg); }, var);
+		}
+
+		/// Get size required after serialization, when all alternatives have the same constant size.
+		/// @note All template parameters are used only to determine if function should be defined.
+		/// @return size_t. Number of bytes used after serialization.
+		template <typename C = VarT>
+		static constexpr auto Size() -> std::enable_if_t<IsSizeFixed<C>(), size_t>
+		{
+			return MaxSize();
 		}
 
 		/// Get size required after serialization.
 		/// @param var. Instance for which size should be found.
+		/// @note All template parameters are used only to determine if function should be defined.
 		/// @return size_t. Number of bytes used after serialization.
-		static size_t Size(VarT const& var)
+		template <typename C = VarT>
+		static auto Size(VarT const& var) -> std::enable_if_t<!IsSizeFixed<C>(), size_t>
 		{
 			return sizeof(size_t) + std::visit([](auto&& arg) { return ByteVector::Size(arg); }, var);
 		}
 
+		/// Get size required to serialize largest alternative.
+		/// Defined only if Size of all alternatives can be determined at compilation time.
+		/// @note All template parameters are used only to determine if function should be defined.
+		/// @return size_t. Upper bound of number of bytes used after serialization.
+		template <typename C = VarT>
+		static constexpr auto MaxSize() -> std::enable_if_t<IsSizeConstexpr<C>(), size_t>
+		{
+			return sizeof(size_t) + std::max({ ByteConverter<Ts>::Size()... });
+		}
+
 		/// Deserialize from ByteView.
 		/// @param bv. Buffer with serialized data.
 		/// @return std::variant.
@@ -219,6 +589,96 @@ namespace FSecure
 			auto idx = bv.Read<size_t>();
 			return Index(idx, [&](auto idx) { return VarT(std::in_place_index<idx()>, bv.Read<std::variant_alternative_t<idx(), VarT>>()); });
 		}
+
+		/// Deserialize from ByteView into existing variant.
+		/// If stored alternative matches serialized one, it is overwritten in place, otherwise new alternative is emplaced.
+		/// @param bv. Buffer with serialized data.
+		/// @param var. Variant to be overwritten.
+		static void From(ByteView& bv, VarT& var)
+		{
+			auto idx = bv.Read<size_t>();
+			Index(idx, [&](auto idx)
+				{
+					if (var.index() == idx())
+						bv.ReadInto(std::get<idx()>(var));
+					else
+						var.template emplace<idx()>(bv.Read<std::variant_alternative_t<idx(), VarT>>());
+				});
+		}
+
+		/// Skip serialized variant without constructing it.
+		/// @param bv. Buffer with serialized data.
+		static void Skip(ByteView& bv)
+		{
+			Index(bv.Read<size_t>(), [&bv](auto idx) { bv.Skip<std::variant_alternative_t<idx(), VarT>>(); });
+		}
+	};
+
+	/// Variant serialized with fixed width, equal to size of the largest alternative.
+	/// Shorter alternatives are padded with zeros, what makes Size of PaddedVariant known at compilation time.
+	/// All alternatives must have Size known at compilation time.
+	/// @tparam Ts. Alternatives of variant.
+	template <typename ...Ts>
+	struct PaddedVariant : std::variant<Ts...>
+	{
+		using std::variant<Ts...>::variant;
+		using std::variant<Ts...>::operator=;
+
+		/// Access underlying std::variant, e.g. for std::visit.
+		constexpr std::variant<Ts...>& AsVariant() { return *this; }
+
+		/// Access underlying std::variant, e.g. for std::visit.
+		constexpr std::variant<Ts...> const& AsVariant() const { return *this; }
+	};
+
+	/// ByteConverter specialization for FSecure::PaddedVariant.
+	template <typename ...Ts>
+	struct ByteConverter<PaddedVariant<Ts...>>
+	{
+		/// Converter of std::variant with the same alternatives.
+		using Base = ByteConverter<std::variant<Ts...>>;
+
+		/// Serialize variant and zero padding to ByteVector.
+		/// @param var. Object to be serialized.
+		/// @param bv. ByteVector, or ByteSpan to be expanded.
+		template <typename Output>
+		static constexpr void To(PaddedVariant<Ts...> const& var, Output& bv)
+		{
+			auto end = bv.size() + Size();
+			Base::To(var.AsVariant(), bv);
+			bv.resize(end);
+		}
+
+		/// Get size required after serialization.
+		/// @return size_t. Number of bytes used after serialization.
+		constexpr static size_t Size()
+		{
+			return Base::MaxSize();
+		}
+
+		/// Deserialize from ByteView.
+		/// @param bv. Buffer with serialized data.
+		/// @return FSecure::PaddedVariant.
+		/// @note First alternative must be default constructible.
+		static PaddedVariant<Ts...> From(ByteView& bv)
+		{
+			auto ret = PaddedVariant<Ts...>{};
+			From(bv, ret);
+			return ret;
+		}
+
+		/// Deserialize from ByteView into existing variant.
+		/// @param bv. Buffer with serialized data.
+		/// @param var. Variant to be overwritten.
+		static void From(ByteView& bv, PaddedVariant<Ts...>& var)
+		{
+			if (Size() > bv.size())
+				BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Cannot read data from ByteView") });
+
+			auto end = bv.data() + Size();
+			Base::From(bv, var.AsVariant());
+			bv.remove_prefix(end - bv.data());
+		}
 	};
 
 	/// Tag allowing reading N bytes from ByteView.
@@ -260,88 +720,107 @@ namespace FSecure
 	template <typename T>
 	struct ByteConverter<T, std::enable_if_t<Utils::IsTuple<T>::value>>
 	{
+	private:
+		/// Check if all elements of tuple can be overwritten. References and constants cannot.
+		template <typename C, size_t ...Is>
+		static constexpr bool IsAssignable(std::index_sequence<Is...>)
+		{
+			return (true && ... && (!std::is_reference_v<std::tuple_element_t<Is, C>> && !std::is_const_v<std::tuple_element_t<Is, C>>));
+		}
+
+		/// Check if all elements of tuple have Size that can be determined at compilation time.
+		template <typename C, size_t ...Is>
+		static constexpr bool IsSizeConstexpr(std::index_sequence<Is...>)
+		{
+			return (true && ... && (Detail::ConverterDeduction<Utils::RemoveCVR<std::tuple_element_t<Is, C>>>::FunctionSize::value == Detail::SizeFunction::compileTime));
+		}
+
+		/// Sum sizes of all elements of tuple known at compilation time.
+		template <size_t ...Is>
+		static constexpr size_t ConstexprSize(std::index_sequence<Is...>)
+		{
+			return (size_t{ 0 } + ... + ByteConverter<Utils::RemoveCVR<std::tuple_element_t<Is, T>>>::Size());
+		}
+
+	public:
 		/// Serialize tuple type to ByteVector.
 		/// @param tupleInstance. Object to be serialized.
-		/// @param bv. ByteVector to be expanded.
-		static void To(T const& tupleInstance, ByteVector& bv)
+		/// @param bv. ByteVector, or ByteSpan to be expanded.
+		template <typename Output>
+		static constexpr void To(T const& tupleInstance, Output& bv)
 		{
-			TupleHandler<T>::Write(bv, tupleInstance);
+			std::apply([&bv](auto const& ...elements) { bv.Store(elements...); }, tupleInstance);
+		}
+
+		/// Get size required after serialization, when all elements have size known at compilation time.
+		/// @note All template parameters are used only to determine if function should be defined.
+		/// @return size_t. Number of bytes used after serialization.
+		template <typename C = T>
+		static constexpr auto Size() -> std::enable_if_t<IsSizeConstexpr<C>(std::make_index_sequence<std::tuple_size_v<C>>{}), size_t>
+		{
+			return ConstexprSize(std::make_index_sequence<std::tuple_size_v<T>>{});
 		}
 
 		/// Get size required after serialization.
 		/// @param tupleInstance. Instance for which size should be found.
+		/// @note All template parameters are used only to determine if function should be defined.
 		/// @return size_t. Number of bytes used after serialization.
-		static size_t Size(T const& tupleInstance)
+		template <typename C = T>
+		static auto Size(T const& tupleInstance) -> std::enable_if_t<!IsSizeConstexpr<C>(std::make_index_sequence<std::tuple_size_v<C>>{}), size_t>
 		{
-			return TupleHandler<T>::Size(tupleInstance);
+			return std::apply([](auto const& ...elements) { return (size_t{ 0 } + ... + ByteVector::Size(elements)); }, tupleInstance);
 		}
 
-
 		/// Deserialize from ByteView.
 		/// @param bv. Buffer with serialized data.
-		/// @return std::tuple.
+		/// @return std::tuple, or std::pair if T is a pair.
 		static auto From(ByteView& bv)
 		{
-			return TupleHandler<T>::ReadExplicit(bv);
+			return Read(bv, std::make_index_sequence<std::tuple_size_v<T>>{});
 		}
 
-	private:
-		/// @tparam Tpl. Tuple type to read/write.
-		/// @tparam N. How many elements of tuple to handle. Functions will use recursion, decrementing N with each call.
-		template <typename Tpl, size_t N = std::tuple_size_v<Tpl>>
-		struct TupleHandler
-		{
-			/// Function responsible for recursively packing data to ByteVector.
-			/// @param self. Reference to ByteVector object using TupleHandler.
-			/// @param t. reference to tuple.
-			static void Write([[maybe_unused]] ByteVector& self, [[maybe_unused]] Tpl const& tpl)
-			{
-				if constexpr (N != 0)
-				{
-					self.Write(std::get<std::tuple_size_v<Tpl> - N>(tpl));
-					TupleHandler<Tpl, N - 1>::Write(self, tpl);
-				}
-			}
+		/// Deserialize from ByteView into existing tuple, reusing resources of its elements.
+		/// @param bv. Buffer with serialized data.
+		/// @param tupleInstance. Tuple to be overwritten.
+		template <typename C = T>
+		static auto From(ByteView& bv, T& tupleInstance) -> std::enable_if_t<IsAssignable<C>(std::make_index_sequence<std::tuple_size_v<C>>{})>
+		{
+			std::apply([&bv](auto& ...elements) { bv.ReadInto(elements...); }, tupleInstance);
+		}
 
-			/// Function responsible for recursively calculating buffer size needed for call with tuple argument.
-			/// @param t. reference to tuple.
-			/// @return size_t number of bytes needed.
-			static size_t Size([[maybe_unused]] Tpl const& tpl)
-			{
-				if constexpr (N != 0)
-					return ByteVector::Size(std::get<std::tuple_size_v<Tpl> - N>(tpl)) + TupleHandler<Tpl, N - 1>::Size(tpl);
-				else
-					return 0;
-			}
+		/// Skip serialized tuple without constructing its elements.
+		/// @param bv. Buffer with serialized data.
+		static void Skip(ByteView& bv)
+		{
+			SkipElements(bv, std::make_index_sequence<std::tuple_size_v<T>>{});
+		}
 
-			/// C++ allows cast from pair to tuple of two, but not other way around.
-			/// This is oversight, because pair is much older concept than tuple, and no proposition was made to expand old type.
-			/// This function ensures, that TupleHandler always returns requested type, so no cast is necessary.
-			static auto ReadExplicit(ByteView& self)
-			{
-				auto tmp = Read(self);
-				if constexpr (Utils::IsPair<Tpl>::value)
-					return std::pair{ std::get<0>(tmp), std::get<1>(tmp) };
-				else
-					return tmp;
-			}
+	private:
+		/// Skip all tuple elements.
+		/// @param bv. Buffer with serialized data.
+		template <size_t ...Is>
+		static void SkipElements([[maybe_unused]] ByteView& bv, std::index_sequence<Is...>)
+		{
+			(bv.Skip<Utils::RemoveCVR<std::tuple_element_t<Is, T>>>(), ...);
+		}
 
-			/// Function responsible for recursively packing data to tuple.
-			/// @param self. Reference to ByteView object using generate method.
-			static auto Read(ByteView& self)
-			{
-				if constexpr (N != 0)
-				{
-					auto current = std::make_tuple(self.Read<Utils::RemoveCVR<std::tuple_element_t<std::tuple_size_v<Tpl> - N, Tpl>>>());
-					auto rest = TupleHandler<Tpl, N - 1>::Read(self);
-					return std::tuple_cat(std::move(current), std::move(rest));
-				}
-				else
-				{
-					return std::tuple<>{};
-				}
-			}
-		};
+		/// Type of tuple element after deserialization.
+		template <size_t I>
+		using Element = decltype(std::declval<ByteView&>().Read<Utils::RemoveCVR<std::tuple_element_t<I, T>>>());
+
+		/// Read all tuple elements.
+		/// C++ allows cast from pair to tuple of two, but not other way around, so requested type is always constructed directly.
+		/// Braced initialization guarantees left to right evaluation order.
+		/// @param bv. Buffer with serialized data.
+		/// @return std::tuple, or std::pair if T is a pair.
+		template <size_t ...Is>
+		static auto Read([[maybe_unused]] ByteView& bv, std::index_sequence<Is...>)
+		{
+			if constexpr (Utils::IsPair<T>::value)
+				return std::pair<Element<Is>...>{ bv.Read<Utils::RemoveCVR<std::tuple_element_t<Is, T>>>()... };
+			else
+				return std::tuple<Element<Is>...>{ bv.Read<Utils::RemoveCVR<std::tuple_element_t<Is, T>>>()... };
+		}
 	};
 
 	/// @brief Class providing simple way of generating ByteConverter of custom types by treating them as tuple.
@@ -392,6 +871,227 @@ namespace FSecure
 			}
 		};
 
+	protected:
+		/// @brief Helper class compatible with Utils::Apply. Counts nullable types.
+		struct CountNullable
+		{
+			template <typename ...Ts>
+			static constexpr auto Apply() -> size_t
+			{
+				return (size_t{ 0 } + ... + size_t{ Detail::Nullable<Utils::RemoveCVR<Ts>>::value });
+			}
+		};
+
+		/// @brief Number of nullable members. When it is not zero, their presence markers are packed into one bitmap preceding all members.
+		/// @note Template parameter is used only to postpone evaluation until ByteConverter<T>::Convert is defined.
+		template <typename C = T>
+		static constexpr size_t NullableCount()
+		{
+			return Utils::Apply<CountNullable, ConvertType<C>>::value;
+		}
+
+		/// @brief Bitmap of presence of nullable members.
+		/// @note Template parameter is used only to postpone evaluation until ByteConverter<T>::Convert is defined.
+		template <typename C = T>
+		using Presence = std::array<uint8_t, (NullableCount<C>() + 7) / 8>;
+
+		/// @brief Check bit of presence bitmap.
+		/// @param presence. Bitmap.
+		/// @param bit. Index of nullable member.
+		template <typename P>
+		static bool IsPresent(P const& presence, size_t bit)
+		{
+			return presence[bit / 8] & (1u << (bit % 8));
+		}
+
+		/// @brief Read presence bitmap.
+		/// @param bv. Buffer with serialized data.
+		template <typename C = T>
+		static Presence<C> ReadPresence(ByteView& bv)
+		{
+			auto ret = Presence<C>{};
+			for (auto& byte : ret)
+				byte = bv.Read<uint8_t>();
+
+			return ret;
+		}
+
+		/// @brief Read members of existing object, in order of tuple returned by Convert.
+		/// Presence bitmap is read first if there are nullable members.
+		/// @param bv. Buffer with serialized data.
+		/// @param members. Members to be overwritten.
+		template <typename ...Ms>
+		static void ReadMembersInto(ByteView& bv, Ms& ...members)
+		{
+			if constexpr (NullableCount() == 0)
+			{
+				bv.ReadInto(members...);
+			}
+			else
+			{
+				auto presence = ReadPresence(bv);
+				auto bit = size_t{ 0 };
+				auto readMember = [&](auto& member)
+				{
+					if constexpr (Detail::Nullable<Utils::RemoveCVR<decltype(member)>>::value)
+						Detail::ReadNullableInto(bv, member, IsPresent(presence, bit++));
+					else
+						bv.ReadInto(member);
+				};
+
+				(readMember(members), ...);
+			}
+		}
+
+		/// @brief Read selected members of existing object, skipping others without constructing them.
+		/// Selected members are recognized by address, so members must be passed in order of tuple returned by Convert.
+		/// @tparam Ms. Pointers to selected members. Members that are not selected are left untouched.
+		/// @param bv. Buffer with serialized data.
+		/// @param obj. Object to be partially overwritten.
+		/// @param members. All serialized members of obj.
+		template <auto ...Ms, typename ...Ns>
+		static void ProjectMembers(ByteView& bv, T& obj, Ns& ...members)
+		{
+			[[maybe_unused]] auto presence = ReadPresence(bv);
+			[[maybe_unused]] auto bit = size_t{ 0 };
+			auto projectMember = [&](auto& member)
+			{
+				using M = Utils::RemoveCVR<decltype(member)>;
+				auto selected = ((static_cast<void const*>(&member) == static_cast<void const*>(&(obj.*Ms))) || ...);
+				if constexpr (Detail::Nullable<M>::value)
+				{
+					auto present = IsPresent(presence, bit++);
+					if (selected)
+						Detail::ReadNullableInto(bv, member, present);
+					else if (present)
+						bv.Skip<typename Detail::Nullable<M>::Value>();
+				}
+				else if (selected)
+				{
+					bv.ReadInto(member);
+				}
+				else
+				{
+					bv.Skip<M>();
+				}
+			};
+
+			(projectMember(members), ...);
+		}
+
+		/// @brief Skip serialized object without constructing its members.
+		/// Not exposed as Skip by default, because converters may shadow From with different format.
+		/// Converter that does not change format can opt in with static void Skip(ByteView& bv) { SkipMembers(bv); }.
+		/// @param bv. Buffer with serialized data.
+		template <typename C = T>
+		static void SkipMembers(ByteView& bv)
+		{
+			if constexpr (NullableCount<C>() == 0)
+				bv.Skip<ConvertType<C>>();
+			else
+				SkipFields(bv, ReadPresence(bv), std::make_index_sequence<std::tuple_size_v<ConvertType<C>>>{});
+		}
+
+	private:
+		/// @brief Type of element of tuple returned by Convert, with qualifiers removed.
+		template <size_t I, typename C = T>
+		using Element = Utils::RemoveCVR<std::tuple_element_t<I, ConvertType<C>>>;
+
+		/// @brief Store nullable member without its own presence marker.
+		/// @param element member to be stored.
+		/// @param bv output ByteVector, or ByteSpan.
+		template <typename E, typename Output>
+		static void StoreField(E const& element, Output& bv)
+		{
+			if constexpr (Detail::Nullable<E>::value)
+			{
+				if (element)
+					bv.Store(*element);
+			}
+			else
+			{
+				bv.Store(element);
+			}
+		}
+
+		/// @brief Set bit of presence bitmap if member is nullable and holds value.
+		/// @param element member to be tested.
+		/// @param presence bitmap to be updated.
+		/// @param bit index of next nullable member. Incremented for nullable members.
+		template <typename E, typename P>
+		static void MarkPresence([[maybe_unused]] E const& element, [[maybe_unused]] P& presence, [[maybe_unused]] size_t& bit)
+		{
+			if constexpr (Detail::Nullable<E>::value)
+			{
+				if (element)
+					presence[bit / 8] |= static_cast<uint8_t>(1u << (bit % 8));
+
+				++bit;
+			}
+		}
+
+		/// @brief Get size of member without presence marker.
+		/// @param element member to be measured.
+		template <typename E>
+		static size_t FieldSize(E const& element)
+		{
+			if constexpr (Detail::Nullable<E>::value)
+				return element ? ByteVector::Size(*element) : 0;
+			else
+				return ByteVector::Size(element);
+		}
+
+		/// @brief Number of nullable elements preceding element I, equal to its bit in presence bitmap.
+		template <size_t ...Is>
+		static constexpr size_t PresenceBit(std::index_sequence<Is...>)
+		{
+			return (size_t{ 0 } + ... + size_t{ Detail::Nullable<Element<Is>>::value });
+		}
+
+		/// @brief Read one element of tuple returned by Convert.
+		/// @param bv. Buffer with serialized data.
+		/// @param presence. Bitmap read from buffer.
+		template <size_t I, typename P>
+		static auto ReadField(ByteView& bv, [[maybe_unused]] P const& presence)
+		{
+			using E = Element<I>;
+			if constexpr (Detail::Nullable<E>::value)
+				return IsPresent(presence, PresenceBit(std::make_index_sequence<I>{})) ? Detail::Nullable<E>::Make(bv.Read<typename Detail::Nullable<E>::Value>()) : E{};
+			else
+				return bv.Read<E>();
+		}
+
+		/// @brief Skip all elements of tuple returned by Convert, after presence bitmap.
+		/// @param bv. Buffer with serialized data.
+		/// @param presence. Bitmap read from buffer.
+		template <typename P, size_t ...Is>
+		static void SkipFields(ByteView& bv, [[maybe_unused]] P const& presence, std::index_sequence<Is...>)
+		{
+			auto skipField = [&](auto index)
+			{
+				using E = Element<index()>;
+				if constexpr (Detail::Nullable<E>::value)
+				{
+					if (IsPresent(presence, PresenceBit(std::make_index_sequence<index()>{})))
+						bv.Skip<typename Detail::Nullable<E>::Value>();
+				}
+				else
+				{
+					bv.Skip<E>();
+				}
+			};
+
+			(skipField(std::integral_constant<size_t, Is>{}), ...);
+		}
+
+		/// @brief Read all elements of tuple returned by Convert, after presence bitmap.
+		/// Braced initialization guarantees left to right evaluation order.
+		template <typename P, size_t ...Is>
+		static auto ReadFields([[maybe_unused]] ByteView& bv, [[maybe_unused]] P const& presence, std::index_sequence<Is...>)
+		{
+			return std::tuple<decltype(ReadField<Is>(bv, presence))...>{ ReadField<Is>(bv, presence)... };
+		}
+
 	public:
 		/// @brief Use it to convert raw data into tuple.
 		/// Allows splitting deserialization into two phases.
@@ -401,7 +1101,10 @@ namespace FSecure
 		/// @return tuple of retrieved data for type construction.
 		static auto Convert(ByteView& bv)
 		{
-			return bv.Read<ConvertType<T>>();
+			if constexpr (NullableCount() == 0)
+				return bv.Read<ConvertType<T>>();
+			else
+				return ReadFields(bv, ReadPresence(bv), std::make_index_sequence<std::tuple_size_v<ConvertType<T>>>{});
 		}
 
 		// From this point forward will be implemented ByteConverter standard interface methods.
@@ -409,10 +1112,26 @@ namespace FSecure
 		/// @brief Default implementation of To method.
 		/// Serializes data treating it as tuple generated by Convert.
 		/// @param obj Object for serialization.
-		/// @param bv output ByteVector with already allocated memory for data.
-		static void To(T const& obj, ByteVector& bv)
+		/// @param bv output ByteVector, or ByteSpan with already allocated memory for data.
+		template <typename Output>
+		static constexpr void To(T const& obj, Output& bv)
 		{
-			bv.Store(ByteConverter<T>::Convert(obj));
+			if constexpr (NullableCount() == 0)
+			{
+				bv.Store(ByteConverter<T>::Convert(obj));
+			}
+			else
+			{
+				auto tpl = ByteConverter<T>::Convert(obj);
+				auto presence = Presence<>{};
+				auto bit = size_t{ 0 };
+				std::apply([&](auto const& ...elements) { (MarkPresence(elements, presence, bit), ...); }, tpl);
+
+				for (auto byte : presence)
+					bv.Store(byte);
+
+				std::apply([&bv](auto const& ...elements) { (StoreField(elements, bv), ...); }, tpl);
+			}
 		}
 
 		/// @brief Default implementation of From method.
@@ -442,7 +1161,10 @@ namespace FSecure
 		template <typename C = T>
 		static auto Size(T const& obj) -> std::enable_if_t<!ConvertHaveConstexprSize<C>::value, size_t>
 		{
-			return ByteVector::Size(ByteConverter<T>::Convert(obj));
+			if constexpr (NullableCount() == 0)
+				return ByteVector::Size(ByteConverter<T>::Convert(obj));
+			else
+				return std::apply([](auto const& ...elements) { return (std::tuple_size_v<Presence<>> + ... + FieldSize(elements)); }, ByteConverter<T>::Convert(obj));
 		}
 	};
 
@@ -472,19 +1194,6 @@ namespace FSecure
 			}
 		};
 
-		/// @brief Function assigning object members with tuple of values using tuple member pointers.
-		/// @tparam PtrTpl Tuple of pointers to members type.
-		/// @tparam ValueTpl Tuple of values type.
-		/// @tparam Is Index sequence used to match tuples one to one.
-		/// @param obj Object to be assigned.
-		/// @param ptrTpl Tuple of pointers to members.
-		/// @param valueTpl Tuple of values.
-		template <typename PtrTpl, typename ValueTpl, size_t ...Is>
-		static void AssignToMembers(T& obj, PtrTpl const& ptrTpl, ValueTpl valueTpl, std::index_sequence<Is...>)
-		{
-			((obj.*(std::get<Is>(ptrTpl)) = std::move(std::get<Is>(valueTpl))), ...);
-		}
-
 	public:
 		/// @brief Default implementation of Convert method used by TupleConverter for serialization.
 		/// Function uses ByteConverter<T>::MemberPointers() to reference T object members.
@@ -497,16 +1206,240 @@ namespace FSecure
 		}
 
 		/// @brief Shadowed TupleConverter<T>::From initalizing only selected members, skipped ones will be default initialized.
+		/// Selected members are read in place. Members using std::pmr::polymorphic_allocator are first bound to resource of Utils::Container::MemoryResourceScope.
 		/// @note T must have default constructor.
 		/// @param bv. Buffer with serialized data.
 		/// @return constructed type.
 		static T From(ByteView& bv)
 		{
 			auto ret = T{};
-			auto ptrTpl = ByteConverter<T>::MemberPointers();
-			auto valueTpl = TupleConverter<T>::Convert(bv);
-			AssignToMembers(ret, ptrTpl, std::move(valueTpl), std::make_index_sequence<std::tuple_size<decltype(ptrTpl)>::value>{});
+			std::apply([&](auto ...ptrs)
+				{
+					(Utils::Container::Rebind(ret.*ptrs), ...);
+					TupleConverter<T>::ReadMembersInto(bv, ret.*ptrs...);
+				}, ByteConverter<T>::MemberPointers());
+
 			return ret;
 		}
+
+		/// @brief Shadowed TupleConverter<T>::From reading selected members directly into existing object.
+		/// Resources of members, like capacity of containers, are reused. Skipped members are left untouched.
+		/// @param bv. Buffer with serialized data.
+		/// @param obj. Object to be overwritten.
+		static void From(ByteView& bv, T& obj)
+		{
+			std::apply([&](auto ...ptrs) { TupleConverter<T>::ReadMembersInto(bv, obj.*ptrs...); }, ByteConverter<T>::MemberPointers());
+		}
+
+		/// @brief Read only selected members into existing object. Other members are skipped without being constructed.
+		/// @tparam Ms. Pointers to selected members, e.g. &T::m_a. Members that are not selected are left untouched.
+		/// @param bv. Buffer with serialized data.
+		/// @param obj. Object to be partially overwritten.
+		/// @see FSecure::Project.
+		template <auto ...Ms>
+		static void ReadProjection(ByteView& bv, T& obj)
+		{
+			std::apply([&](auto ...ptrs) { TupleConverter<T>::template ProjectMembers<Ms...>(bv, obj, obj.*ptrs...); }, ByteConverter<T>::MemberPointers());
+		}
+	};
+
+	/// @brief Class providing ByteConverter of aggregate, serializing all members in order of declaration.
+	/// ByteConverter can use this functionality by inheriting from AggregateConverter, without listing members.
+	/// Wire format is the same as of TupleConverter listing all members.
+	/// Trivially copyable aggregates without padding, whose members are all trivially serializable, are copied with one memcpy.
+	/// @code template <> struct ByteConverter<Message> : AggregateConverter<Message> {}; @endcode
+	/// @tparam T Type for serialization. Must be reflectable.
+	/// @see Utils::Reflection for limitations.
+	template <typename T>
+	struct AggregateConverter : TupleConverter<T>
+	{
+		static_assert(Utils::Reflection::IsReflectable<T>::value, "AggregateConverter requires aggregate whose members can be accessed with structured bindings");
+
+	private:
+		/// @brief Helper class compatible with Utils::Apply. Checks if members have the same layout in memory and in serialized form.
+		struct IsLayoutPacked
+		{
+			template <typename ...Ms>
+			static constexpr auto Apply()
+			{
+				return (Detail::TriviallySerializable<Utils::RemoveCVR<Ms>>::value && ...) && (size_t{ 0 } + ... + sizeof(Utils::RemoveCVR<Ms>)) == sizeof(T);
+			}
+		};
+
+	public:
+		/// Serialized form is identical to object representation in memory.
+		static constexpr bool TriviallySerializable = std::is_trivially_copyable_v<T>
+			&& Utils::Apply<IsLayoutPacked, decltype(Utils::Reflection::Tie(std::declval<T&>()))>::value;
+
+		/// @brief Reference all members of aggregate.
+		/// @param obj object to be serialized.
+		/// @return tuple of values to be serialized.
+		static constexpr auto Convert(T const& obj)
+		{
+			return std::apply([](auto const& ...members) { return Utils::MakeConversionTuple(members...); }, Utils::Reflection::Tie(obj));
+		}
+
+		/// @brief Serialize aggregate.
+		/// @param obj Object for serialization.
+		/// @param bv output ByteVector, or ByteSpan with already allocated memory for data.
+		template <typename Output>
+		static constexpr void To(T const& obj, Output& bv)
+		{
+			if constexpr (TriviallySerializable && !Detail::StoresElementwise<Output>::value)
+			{
+				auto oldSize = bv.size();
+				bv.resize(oldSize + sizeof(T));
+				memcpy(bv.data() + oldSize, &obj, sizeof(T));
+			}
+			else
+			{
+				TupleConverter<T>::To(obj, bv);
+			}
+		}
+
+		/// @brief Deserialize aggregate.
+		/// @param bv. Buffer with serialized data.
+		/// @return constructed type.
+		static T From(ByteView& bv)
+		{
+			if constexpr (TriviallySerializable)
+			{
+				T ret;
+				From(bv, ret);
+				return ret;
+			}
+			else
+			{
+				return TupleConverter<T>::From(bv);
+			}
+		}
+
+		/// @brief Deserialize into existing aggregate, reusing resources of its members.
+		/// @param bv. Buffer with serialized data.
+		/// @param obj. Object to be overwritten.
+		static void From(ByteView& bv, T& obj)
+		{
+			if constexpr (TriviallySerializable)
+			{
+				if (sizeof(T) > bv.size())
+					BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Cannot read data from ByteView") });
+
+				memcpy(&obj, bv.data(), sizeof(T));
+				bv.remove_prefix(sizeof(T));
+			}
+			else
+			{
+				std::apply([&bv](auto& ...members) { TupleConverter<T>::ReadMembersInto(bv, members...); }, Utils::Reflection::Tie(obj));
+			}
+		}
+
+		/// @brief Skip serialized aggregate without constructing its members.
+		/// @param bv. Buffer with serialized data.
+		static void Skip(ByteView& bv)
+		{
+			TupleConverter<T>::SkipMembers(bv);
+		}
+
+		/// @brief Read only selected members into existing aggregate. Other members are skipped without being constructed.
+		/// @tparam Ms. Pointers to selected members. Members that are not selected are left untouched.
+		/// @param bv. Buffer with serialized data.
+		/// @param obj. Object to be partially overwritten.
+		/// @see FSecure::Project.
+		template <auto ...Ms>
+		static void ReadProjection(ByteView& bv, T& obj)
+		{
+			std::apply([&](auto& ...members) { TupleConverter<T>::template ProjectMembers<Ms...>(bv, obj, members...); }, Utils::Reflection::Tie(obj));
+		}
+	};
+
+	/// Tag reading only selected members of object. Other members are skipped without being constructed.
+	/// Object must be serialized by converter providing ReadProjection, i.e. PointerTupleConverter, TaggedConverter, or AggregateConverter.
+	/// Reading Project returns value of selected member, or std::tuple of values if more members were selected.
+	/// @code auto [id, name] = someByteView.Read<Project<&Record::m_Id, &Record::m_Name>>(); @endcode
+	/// @tparam M. Pointer to the first selected member.
+	/// @tparam Ms. Pointers to other selected members of the same class.
+	template <auto M, auto ...Ms>
+	class Project
+	{
+		/// This class should never be instantiated.
+		Project() = delete;
+	};
+
+	/// Tag reading object with only selected members. Other members keep values of default constructed object.
+	/// @code auto record = someByteView.Read<Partial<&Record::m_Id, &Record::m_Name>>(); @endcode
+	/// @see FSecure::Project.
+	template <auto M, auto ...Ms>
+	class Partial
+	{
+		/// This class should never be instantiated.
+		Partial() = delete;
+	};
+
+	namespace Detail
+	{
+		/// Read selected members of default constructed object.
+		/// @tparam M. Pointer to the first selected member.
+		/// @tparam Ms. Pointers to other selected members of the same class.
+		template <auto M, auto ...Ms>
+		struct Projection
+		{
+			/// Class containing selected members.
+			using Class = typename Utils::MemberOf<decltype(M)>::Class;
+
+			static_assert((std::is_same_v<Class, typename Utils::MemberOf<decltype(Ms)>::Class> && ...), "Projected members must belong to the same class");
+
+			/// Read object with selected members.
+			/// @param bv. Buffer with serialized data.
+			static Class Read(ByteView& bv)
+			{
+				auto ret = Class{};
+				ByteConverter<Class>::template ReadProjection<M, Ms...>(bv, ret);
+				return ret;
+			}
+		};
+	}
+
+	/// ByteConverter specialization for FSecure::Project.
+	template <auto M, auto ...Ms>
+	struct ByteConverter<Project<M, Ms...>>
+	{
+		/// Read selected members.
+		/// @param bv. Buffer with serialized data.
+		/// @return value of selected member, or std::tuple of values.
+		static auto From(ByteView& bv)
+		{
+			auto obj = Detail::Projection<M, Ms...>::Read(bv);
+			if constexpr (sizeof...(Ms) == 0)
+				return std::move(obj.*M);
+			else
+				return std::tuple<Utils::RemoveCVR<decltype(obj.*M)>, Utils::RemoveCVR<decltype(obj.*Ms)>...>{ std::move(obj.*M), std::move(obj.*Ms)... };
+		}
+
+		/// Skip whole object.
+		/// @param bv. Buffer with serialized data.
+		static void Skip(ByteView& bv)
+		{
+			bv.Skip<typename Detail::Projection<M, Ms...>::Class>();
+		}
+	};
+
+	/// ByteConverter specialization for FSecure::Partial.
+	template <auto M, auto ...Ms>
+	struct ByteConverter<Partial<M, Ms...>>
+	{
+		/// Read object with selected members.
+		/// @param bv. Buffer with serialized data.
+		/// @return object with selected members.
+		static auto From(ByteView& bv)
+		{
+			return Detail::Projection<M, Ms...>::Read(bv);
+		}
+
+		/// Skip whole object.
+		/// @param bv. Buffer with serialized data.
+		static void Skip(ByteView& bv)
+		{
+			bv.Skip<typename Detail::Projection<M, Ms...>::Class>();
+		}
 	};
 }
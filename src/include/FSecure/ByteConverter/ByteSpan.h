@@ -0,0 +1,244 @@
+#pragma once
+
+#include "ByteConverter.h"
+
+#include <iterator>
+
+namespace FSecure
+{
+	/// Forward declaration
+	class ByteSpan;
+
+	namespace Detail
+	{
+		namespace Impl
+		{
+			namespace ToConcept
+			{
+				template <typename T, typename = void>
+				struct ExpandSpan
+					: std::false_type {};
+
+				template <typename T>
+				struct ExpandSpan<T, decltype(void(ByteConverter<T>::To(std::declval<T>(), std::declval<ByteSpan&>())))>
+					: std::true_type {};
+			}
+		}
+
+		/// Checks if ByteConverter can serialize directly into ByteSpan.
+		/// Built-in converters define To as template over output type. Converters taking only ByteVector& are not able to.
+		template <typename T>
+		struct ExpandSpanCondition : Impl::ToConcept::ExpandSpan<T> {};
+
+		/// Checks if T is writable contiguous memory, e.g. std::vector<uint8_t>, ByteArray, or uint8_t[N].
+		template <typename T, typename = void>
+		struct IsWritableBuffer : std::false_type {};
+
+		template <typename T>
+		struct IsWritableBuffer<T, std::enable_if_t<std::is_same_v<decltype(std::data(std::declval<T&>())), std::uint8_t*>, decltype(void(std::size(std::declval<T&>())))>>
+			: std::true_type {};
+	}
+
+	/// Non owning, writable buffer with fixed capacity.
+	/// Serializes the same way as ByteVector, but never reallocates. Writing past capacity throws std::out_of_range.
+	/// Types with converters accepting only ByteVector, e.g. To(T const&, ByteVector&), are serialized to temporary ByteVector and copied.
+	/// Such writes allocate on the heap. Define To as template over output type, to serialize them in place.
+	class ByteSpan
+	{
+	public:
+		/// Type of stored values.
+		using ValueType = std::uint8_t;
+
+		/// Create empty span over memory.
+		/// @param data. Beginning of memory.
+		/// @param capacity. Size of memory.
+		ByteSpan(std::uint8_t* data, size_t capacity)
+			: m_Data{ data }
+			, m_Size{ 0 }
+			, m_Capacity{ capacity }
+		{
+		}
+
+		/// Create empty span over ByteArray.
+		/// @param array. Memory to be written.
+		template <size_t N>
+		ByteSpan(ByteArray<N>& array)
+			: ByteSpan{ array.data(), N }
+		{
+		}
+
+		/// Write content of provided objects after already written data.
+		/// @param arg. Object to be stored.
+		/// @param args. Optional other objects to be stored.
+		/// @return itself to allow chaining.
+		/// @throws std::out_of_range if capacity is exceeded. Already written data is left unchanged.
+		template <typename T, typename ...Ts, typename std::enable_if_t<Detail::WriteCondition<T, Ts...>::value, int> = 0>
+		ByteSpan& Write(T const& arg, Ts const& ...args)
+		{
+			return Store(arg, args...);
+		}
+
+		/// Write content of provided objects.
+		/// Supports ByteView and ByteVector.
+		/// Does not write header with size.
+		/// @param args. Objects to be stored.
+		/// @return itself to allow chaining.
+		template <typename ...Ts, typename std::enable_if_t<Detail::ConcatCondition<Ts...>::value, int> = 0>
+		ByteSpan& Concat(Ts const& ...args)
+		{
+			auto oldSize = size();
+			resize(oldSize + (args.size() + ...));
+			auto ptr = data() + oldSize;
+			((memcpy(ptr, args.data(), args.size()), (ptr += args.size())), ...);
+			return *this;
+		}
+
+		/// Change number of written bytes. New bytes are zeroed.
+		/// @param newSize. Number of written bytes.
+		/// @throws std::out_of_range if newSize exceeds capacity.
+		void resize(size_t newSize)
+		{
+			if (newSize > m_Capacity)
+				BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Cannot write data to ByteSpan") });
+
+			if (newSize > m_Size)
+				memset(m_Data + m_Size, 0, newSize - m_Size);
+
+			m_Size = newSize;
+		}
+
+		/// Forget written data.
+		void clear()
+		{
+			m_Size = 0;
+		}
+
+		/// Get beginning of memory.
+		std::uint8_t* data()
+		{
+			return m_Data;
+		}
+
+		/// Get beginning of memory.
+		std::uint8_t const* data() const
+		{
+			return m_Data;
+		}
+
+		/// Get number of written bytes.
+		size_t size() const
+		{
+			return m_Size;
+		}
+
+		/// Get size of memory.
+		size_t capacity() const
+		{
+			return m_Capacity;
+		}
+
+		/// Check if nothing was written.
+		bool empty() const
+		{
+			return !m_Size;
+		}
+
+		/// Get view of written data.
+		operator ByteView() const
+		{
+			return { m_Data, m_Size };
+		}
+
+	private:
+		/// Store custom types.
+		/// @param args. Objects to be stored.
+		/// @return itself to allow chaining.
+		template<typename ...Ts, typename std::enable_if_t<Detail::WriteCondition<Ts...>::value, int> = 0>
+		ByteSpan& Store(Ts const& ...args)
+		{
+			auto oldSize = size();
+			BYTE_CONVERTER_TRY
+			{
+				(StoreOne(args), ...);
+				return *this;
+			}
+			BYTE_CONVERTER_CATCH (...)
+			{
+				m_Size = oldSize;
+				BYTE_CONVERTER_THROW();
+			}
+		}
+
+		/// Store one custom type.
+		/// @param arg. Object to be stored.
+		template<typename T>
+		void StoreOne(T const& arg)
+		{
+			BYTE_CONVERTER_METRICS_PROBE(write, T, size());
+			using Deduction = typename Detail::ConverterDeduction<T>::FunctionTo;
+			if constexpr (Detail::ExpandSpanCondition<T>::value)
+				ByteConverter<T>::To(arg, *this);
+			else if constexpr (Deduction::value == Deduction::type::createsContainer)
+				Concat(ByteConverter<T>::To(arg));
+			else // Converter expands only ByteVector, so temporary buffer is allocated.
+				Concat(ByteVector::Create(arg));
+
+			BYTE_CONVERTER_METRICS_RECORD(size());
+		}
+
+		/// Beginning of memory.
+		std::uint8_t* m_Data;
+
+		/// Number of written bytes.
+		size_t m_Size;
+
+		/// Size of memory.
+		size_t m_Capacity;
+
+		/// Declaration of friendship.
+		template <typename , typename>
+		friend struct ByteConverter;
+
+		/// Declaration of friendship.
+		template <typename>
+		friend class TupleConverter;
+
+		/// Declaration of friendship.
+		template <typename>
+		friend struct PointerTupleConverter;
+
+		/// Declaration of friendship.
+		template <typename>
+		friend struct TaggedConverter;
+	};
+
+	/// Serialize objects into memory owned by caller, given as pointer and capacity.
+	/// Required size is checked with ByteVector::Size before anything is written.
+	/// Named differently than WriteInto, so that capacity is never confused with serialized object.
+	/// @param data. Beginning of memory.
+	/// @param capacity. Size of memory.
+	/// @param arg. Object to be stored.
+	/// @param args. Optional other objects to be stored.
+	/// @return number of bytes written.
+	/// @throws std::out_of_range if memory is too small.
+	template <typename T, typename ...Ts, typename std::enable_if_t<Detail::WriteCondition<T, Ts...>::value, int> = 0>
+	size_t WriteIntoMemory(std::uint8_t* data, size_t capacity, T const& arg, Ts const& ...args)
+	{
+		if (ByteVector::Size(arg, args...) > capacity)
+			BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Buffer is too small for serialized data") });
+
+		return ByteSpan{ data, capacity }.Write(arg, args...).size();
+	}
+
+	/// Serialize objects into memory owned by caller.
+	/// @param buffer. Contiguous memory providing data() and size(), e.g. ByteArray, std::vector<uint8_t>, or uint8_t[N].
+	/// @param arg. Object to be stored.
+	/// @param args. Optional other objects to be stored.
+	/// @return number of bytes written.
+	/// @throws std::out_of_range if buffer is too small.
+	template <typename Buffer, typename T, typename ...Ts, typename std::enable_if_t<Detail::IsWritableBuffer<Buffer>::value && Detail::WriteCondition<T, Ts...>::value, int> = 0>
+	size_t WriteInto(Buffer& buffer, T const& arg, Ts const& ...args)
+	{
+		return WriteIntoMemory(std::data(buffer), std::size(buffer), arg, args...);
+	}
+}
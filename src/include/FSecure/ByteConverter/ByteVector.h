@@ -1,7 +1,10 @@
 #pragma once
 
 #include "Utils.h"
+#include "Metrics.h"
+#include "AllocationStatistics.h"
 
+#include <algorithm>
 #include <limits>
 #include <cstring>
 #include <string>
@@ -203,6 +206,24 @@ namespace FSecure
 
 		}
 
+		/// Take ownership of buffer without copying.
+		/// @param buffer. Buffer to adopt. Left empty.
+		/// @return ByteVector using memory of buffer.
+		static ByteVector Adopt(std::vector<uint8_t>&& buffer)
+		{
+			return ByteVector(std::move(buffer));
+		}
+
+		/// Give up ownership of buffer without copying.
+		/// Memory is not zeroed, even if BYTEVECTOR_ZERO_MEMORY_DESTRUCTION is defined.
+		/// @return underlying buffer. ByteVector is left empty.
+		std::vector<uint8_t> Release()
+		{
+			auto ret = Super{};
+			std::swap(static_cast<Super&>(*this), ret);
+			return ret;
+		}
+
 		// Enable methods.
 		using Super::vector;
 		using Super::value_type;
@@ -250,19 +271,79 @@ namespace FSecure
 		friend inline bool operator==(ByteVector const& lhs, ByteVector const& rhs);
 		friend inline bool operator!=(ByteVector const& lhs, ByteVector const& rhs);
 
+		/// Strategy of increasing capacity when appended data does not fit.
+		enum class GrowthPolicy
+		{
+			/// At least double capacity. Used by default.
+			geometric,
+
+			/// Allocate exactly as much as is needed.
+			exact,
+		};
+
+		/// Ensure that additional bytes can be appended without reallocation.
+		/// @param additional. Number of bytes that will be appended.
+		/// @param policy. Strategy of increasing capacity.
+		void Grow(size_t additional, GrowthPolicy policy)
+		{
+			auto required = size() + additional;
+			if (required <= capacity())
+				return;
+
+			if (policy == GrowthPolicy::geometric)
+				required = (std::max)(required, 2 * capacity());
+
+			reserve(required);
+		}
+
 		/// Write content of of provided objects.
 		/// Supports arithmetic types, and basic iterable types.
 		/// Include ByteConverter.h to add support for common types like enum, std::tuple and others.
 		/// Create specialization on ByteConverter for custom types or template types to expand existing serialization functionality.
+		/// Capacity grows geometrically, so chained calls take amortized constant time per byte.
 		/// @param arg. Object to be stored.
 		/// @param args. Optional other objects to be stored.
 		/// @return itself to allow chaining.
 		template <typename T, typename ...Ts, typename std::enable_if_t<Detail::WriteCondition<T, Ts...>::value, int> = 0>
 		ByteVector& Write(T const& arg, Ts const& ...args)
 		{
-			reserve(size() + Size<T, Ts...>(arg, args...));
-			Store<T, Ts...>(arg, args...);
-			return *this;
+			return WriteAt<GrowthPolicy::geometric>({}, arg, args...);
+		}
+
+		/// Write content of of provided objects, choosing how capacity is increased.
+		/// @code bv.Write<ByteVector::GrowthPolicy::exact>(a, b); @endcode
+		/// @tparam Policy. Strategy of increasing capacity if data does not fit.
+		/// @param arg. Object to be stored.
+		/// @param args. Optional other objects to be stored.
+		/// @return itself to allow chaining.
+		template <GrowthPolicy Policy, typename T, typename ...Ts, typename std::enable_if_t<Detail::WriteCondition<T, Ts...>::value, int> = 0>
+		ByteVector& Write(T const& arg, Ts const& ...args)
+		{
+			return WriteAt<Policy>({}, arg, args...);
+		}
+
+		/// Write content of of provided objects, attributing call to site in AllocationStatistics.
+		/// @code bv.Write(AllocationStatistics::CallSite::Current(), a, b); @endcode
+		/// @param site. Location of call.
+		/// @param arg. Object to be stored.
+		/// @param args. Optional other objects to be stored.
+		/// @return itself to allow chaining.
+		template <typename T, typename ...Ts, typename std::enable_if_t<Detail::WriteCondition<T, Ts...>::value, int> = 0>
+		ByteVector& Write(AllocationStatistics::CallSite site, T const& arg, Ts const& ...args)
+		{
+			return WriteAt<GrowthPolicy::geometric>(site, arg, args...);
+		}
+
+		/// Write content of of provided objects, choosing how capacity is increased, and attributing call to site in AllocationStatistics.
+		/// @tparam Policy. Strategy of increasing capacity if data does not fit.
+		/// @param site. Location of call.
+		/// @param arg. Object to be stored.
+		/// @param args. Optional other objects to be stored.
+		/// @return itself to allow chaining.
+		template <GrowthPolicy Policy, typename T, typename ...Ts, typename std::enable_if_t<Detail::WriteCondition<T, Ts...>::value, int> = 0>
+		ByteVector& Write(AllocationStatistics::CallSite site, T const& arg, Ts const& ...args)
+		{
+			return WriteAt<Policy>(site, arg, args...);
 		}
 
 		/// Write content of of provided objects.
@@ -273,19 +354,54 @@ namespace FSecure
 		template <typename ...Ts, typename std::enable_if_t<Detail::ConcatCondition<Ts...>::value, int> = 0>
 		ByteVector& Concat(Ts const& ...args)
 		{
-			auto oldSize = size();
-			BYTE_CONVERTER_TRY
+			return ConcatAt({}, args...);
+		}
+
+		/// Write content of of provided objects, attributing call to site in AllocationStatistics.
+		/// Does not write header with size.
+		/// @param site. Location of call.
+		/// @param args. Objects to be stored.
+		/// @return itself to allow chaining.
+		template <typename ...Ts, typename std::enable_if_t<Detail::ConcatCondition<Ts...>::value, int> = 0>
+		ByteVector& Concat(AllocationStatistics::CallSite site, Ts const& ...args)
+		{
+			return ConcatAt(site, args...);
+		}
+
+		/// Append content of ByteVector, that is no longer needed.
+		/// If this object is empty, and other has at least the same capacity, buffer of other is taken over without copying.
+		/// Otherwise data is copied, so memory already reserved by this object is not dropped.
+		/// Does not write header with size.
+		/// @param other. Object to be appended. Left empty.
+		/// @return itself to allow chaining.
+		ByteVector& Concat(ByteVector&& other)
+		{
+			return Concat(AllocationStatistics::CallSite{}, std::move(other));
+		}
+
+		/// Append content of ByteVector, that is no longer needed, attributing call to site in AllocationStatistics.
+		/// @param site. Location of call.
+		/// @param other. Object to be appended. Left empty.
+		/// @return itself to allow chaining.
+		ByteVector& Concat(AllocationStatistics::CallSite site, ByteVector&& other)
+		{
+			if (!empty() || other.capacity() < capacity())
 			{
-				resize(oldSize + (args.size() + ...));
-				auto ptr = data() + oldSize;
-				((memcpy(ptr, args.data(), args.size()), (ptr += args.size())), ...);
+				ConcatAt(site, std::as_const(other));
+#if defined BYTEVECTOR_ZERO_MEMORY_DESTRUCTION
+				// Size is dropped by clear, so destructor of other would not wipe copied data.
+				other.Clear();
+#endif
+				other.clear();
 				return *this;
 			}
-			BYTE_CONVERTER_CATCH (...)
-			{
-				resize(oldSize);
-				BYTE_CONVERTER_THROW();
-			}
+
+			std::swap(static_cast<Super&>(*this), static_cast<Super&>(other));
+			other.clear();
+
+			// Buffer was adopted, so call is recorded without allocation.
+			AllocationStatistics::Probe{ AllocationStatistics::Operation::concat, capacity(), 0, site }.Record(capacity(), size());
+			return *this;
 		}
 
 		/// Create new ByteVector with Variadic list of parameters.
@@ -296,27 +412,33 @@ namespace FSecure
 		template <typename T, typename ...Ts, typename std::enable_if_t<Detail::WriteCondition<T, Ts...>::value, int> = 0>
 		static ByteVector Create(T const& arg, Ts const& ...args)
 		{
-			return std::move(ByteVector{}.Write(arg, args...));
+			return CreateAt({}, arg, args...);
+		}
+
+		/// Create new ByteVector with Variadic list of parameters, attributing call to site in AllocationStatistics.
+		/// @code auto bv = ByteVector::Create(AllocationStatistics::CallSite::Current(), a, b); @endcode
+		/// @param site. Location of call.
+		/// @param arg. Object to be stored.
+		/// @param args. Optional other objects to be stored.
+		template <typename T, typename ...Ts, typename std::enable_if_t<Detail::WriteCondition<T, Ts...>::value, int> = 0>
+		static ByteVector Create(AllocationStatistics::CallSite site, T const& arg, Ts const& ...args)
+		{
+			return CreateAt(site, arg, args...);
 		}
 
-		/// Calculate the size that the argument will take in memory
+		/// Calculate the size that the arguments will take in memory
 		/// @param arg. Argument to be stored.
-		/// @param args. Rest of types that will be handled with recursion.
+		/// @param args. Optional other arguments to be stored.
 		/// @return size_t number of bytes needed.
 		template<typename T, typename ...Ts>
-		static size_t Size([[maybe_unused]] T const& arg, Ts const& ...args)
+		static size_t Size(T const& arg, Ts const& ...args)
 		{
-			using Deduction = typename Detail::ConverterDeduction<T>::FunctionSize;
-			if constexpr (sizeof...(args) != 0)
-				return Size(arg) + Size(args...);
-			else if constexpr (Deduction::value == Deduction::type::compileTime)
-				return ByteConverter<T>::Size();
-			else if constexpr (Deduction::value == Deduction::type::runTime)
-				return ByteConverter<T>::Size(arg);
-			else if constexpr (Deduction::value == Deduction::type::absent)
-				return ByteConverter<T>::To(arg).size();
+			return (SizeOne(arg) + ... + SizeOne(args));
 		}
 
+		/// Declaration of builder class.
+		class Builder;
+
 		/// Zero memory. Not optimized out during destruction.
 		void Clear()
 		{
@@ -324,25 +446,82 @@ namespace FSecure
 		}
 
 	private:
-		/// Store custom type.
-		/// @param arg. Object to be stored. There must exsist FSecure::ByteConverter<T>::To method avalible to store custom type.
-		/// @param args. Rest of objects that will be handled with recursion.
+		/// Write content of of provided objects, recording location of caller.
+		/// @tparam Policy. Strategy of increasing capacity if data does not fit.
+		/// @param site. Location of call to public entry point.
+		/// @param args. Objects to be stored.
 		/// @return itself to allow chaining.
-		template<typename T, typename ...Ts, typename std::enable_if_t<Detail::WriteCondition<T, Ts...>::value, int> = 0>
-		ByteVector& Store(T const& arg, Ts const& ...args)
+		template <GrowthPolicy Policy, typename ...Ts>
+		ByteVector& WriteAt(AllocationStatistics::CallSite site, Ts const& ...args)
+		{
+			auto probe = AllocationStatistics::Probe{ AllocationStatistics::Operation::write, capacity(), size(), site };
+			Grow(Size(args...), Policy);
+			Store(args...);
+			probe.Record(capacity(), size());
+			return *this;
+		}
+
+		/// Write content of of provided objects without header with size, recording location of caller.
+		/// @param site. Location of call to public entry point.
+		/// @param args. Objects to be stored.
+		/// @return itself to allow chaining.
+		template <typename ...Ts>
+		ByteVector& ConcatAt(AllocationStatistics::CallSite site, Ts const& ...args)
 		{
 			auto oldSize = size();
+			auto probe = AllocationStatistics::Probe{ AllocationStatistics::Operation::concat, capacity(), oldSize, site };
 			BYTE_CONVERTER_TRY
 			{
-				using Deduction = typename Detail::ConverterDeduction<T>::FunctionTo;
-				if constexpr (Deduction::value == Deduction::type::createsContainer)
-					Concat(ByteConverter<T>::To(arg));
-				else
-					ByteConverter<T>::To(arg, *this);
+				resize(oldSize + (args.size() + ...));
+				auto ptr = data() + oldSize;
+				((memcpy(ptr, args.data(), args.size()), (ptr += args.size())), ...);
+				probe.Record(capacity(), size());
+				return *this;
+			}
+			BYTE_CONVERTER_CATCH (...)
+			{
+				resize(oldSize);
+				BYTE_CONVERTER_THROW();
+			}
+		}
 
-				if constexpr (sizeof...(Ts) != 0)
-					Store(args...);
+		/// Create new ByteVector, recording location of caller.
+		/// @param site. Location of call to public entry point.
+		/// @param args. Objects to be stored.
+		template <typename ...Ts>
+		static ByteVector CreateAt(AllocationStatistics::CallSite site, Ts const& ...args)
+		{
+			auto probe = AllocationStatistics::Probe{ AllocationStatistics::Operation::create, 0, 0, site };
+			auto ret = std::move(ByteVector{}.WriteAt<GrowthPolicy::exact>({}, args...));
+			probe.Record(ret.capacity(), ret.size());
+			return ret;
+		}
+
+		/// Calculate the size that one argument will take in memory
+		/// @param arg. Argument to be stored.
+		/// @return size_t number of bytes needed.
+		template<typename T>
+		static size_t SizeOne([[maybe_unused]] T const& arg)
+		{
+			using Deduction = typename Detail::ConverterDeduction<T>::FunctionSize;
+			if constexpr (Deduction::value == Deduction::type::compileTime)
+				return ByteConverter<T>::Size();
+			else if constexpr (Deduction::value == Deduction::type::runTime)
+				return ByteConverter<T>::Size(arg);
+			else if constexpr (Deduction::value == Deduction::type::absent)
+				return ByteConverter<T>::To(arg).size();
+		}
 
+		/// Store custom types.
+		/// @param args. Objects to be stored. There must exsist FSecure::ByteConverter<T>::To method avalible to store each type.
+		/// @return itself to allow chaining.
+		template<typename ...Ts, typename std::enable_if_t<Detail::WriteCondition<Ts...>::value, int> = 0>
+		ByteVector& Store(Ts const& ...args)
+		{
+			auto oldSize = size();
+			BYTE_CONVERTER_TRY
+			{
+				(StoreOne(args), ...);
 				return *this;
 			}
 			BYTE_CONVERTER_CATCH (...)
@@ -352,6 +531,21 @@ namespace FSecure
 			}
 		}
 
+		/// Store one custom type.
+		/// @param arg. Object to be stored.
+		template<typename T>
+		void StoreOne(T const& arg)
+		{
+			BYTE_CONVERTER_METRICS_PROBE(write, T, size());
+			using Deduction = typename Detail::ConverterDeduction<T>::FunctionTo;
+			if constexpr (Deduction::value == Deduction::type::createsContainer)
+				Concat(ByteConverter<T>::To(arg));
+			else
+				ByteConverter<T>::To(arg, *this);
+
+			BYTE_CONVERTER_METRICS_RECORD(size());
+		}
+
 		/// Declaration of friendship.
 		template <typename , typename>
 		friend struct ByteConverter;
@@ -363,6 +557,81 @@ namespace FSecure
 		/// Declaration of friendship.
 		template <typename>
 		friend struct PointerTupleConverter;
+
+		/// Declaration of friendship.
+		template <typename>
+		friend struct TaggedConverter;
+	};
+
+	/// Helper for incremental assembly of message.
+	/// Appends with geometric growth, and optionally releases unused capacity when message is finished.
+	/// @code auto message = ByteVector::Builder{ expectedSize }.Write(header).Write(body).Finish(true); @endcode
+	class ByteVector::Builder
+	{
+	public:
+		/// Create builder.
+		/// @param expectedSize. Number of bytes to reserve up front.
+		explicit Builder(size_t expectedSize = 0)
+		{
+			m_Buffer.reserve(expectedSize);
+		}
+
+		/// Append serialized objects.
+		/// @see ByteVector::Write.
+		/// @return itself to allow chaining.
+		template <typename ...Ts>
+		Builder& Write(Ts const& ...args)
+		{
+			m_Buffer.Write<GrowthPolicy::geometric>(args...);
+			return *this;
+		}
+
+		/// Append raw content of ByteView and ByteVector objects.
+		/// @see ByteVector::Concat.
+		/// @return itself to allow chaining.
+		template <typename ...Ts>
+		Builder& Concat(Ts const& ...args)
+		{
+			m_Buffer.Grow((size_t{ 0 } + ... + args.size()), GrowthPolicy::geometric);
+			m_Buffer.Concat(args...);
+			return *this;
+		}
+
+		/// Ensure that additional bytes can be appended without reallocation.
+		/// @param additional. Number of bytes that will be appended.
+		/// @return itself to allow chaining.
+		Builder& Reserve(size_t additional)
+		{
+			m_Buffer.Grow(additional, GrowthPolicy::exact);
+			return *this;
+		}
+
+		/// Get number of bytes written so far.
+		size_t Size() const
+		{
+			return m_Buffer.size();
+		}
+
+		/// Get data written so far.
+		ByteVector const& Buffer() const
+		{
+			return m_Buffer;
+		}
+
+		/// Finish assembly. Builder is left empty.
+		/// @param shrinkToFit. Release unused capacity.
+		/// @return assembled message.
+		ByteVector Finish(bool shrinkToFit = false)
+		{
+			if (shrinkToFit)
+				m_Buffer.shrink_to_fit();
+
+			return std::move(m_Buffer);
+		}
+
+	private:
+		/// Message being assembled.
+		ByteVector m_Buffer;
 	};
 
 	namespace Literals
@@ -6,6 +6,50 @@
 
 namespace FSecure
 {
+	namespace Detail
+	{
+		namespace Impl
+		{
+			namespace FromConcept
+			{
+				template <typename T, typename = void>
+				struct Assign
+					: std::false_type {};
+
+				template <typename T>
+				struct Assign<T, decltype(void(ByteConverter<T>::From(std::declval<ByteView&>(), std::declval<T&>())))>
+					: std::true_type {};
+			}
+
+			namespace SkipConcept
+			{
+				template <typename T, typename = void>
+				struct Skip
+					: std::false_type {};
+
+				template <typename T>
+				struct Skip<T, decltype(void(ByteConverter<T>::Skip(std::declval<ByteView&>())))>
+					: std::true_type {};
+			}
+		}
+
+		/// Checks if ByteConverter can deserialize into existing object, reusing its resources.
+		/// Such converter defines static void From(ByteView&, T&) alongside regular From.
+		template <typename T>
+		struct ReadIntoCondition
+		{
+			static constexpr bool value = !std::is_volatile_v<T> && Impl::FromConcept::Assign<Utils::RemoveCVR<T>>::value;
+		};
+
+		/// Checks if ByteConverter can move ByteView past serialized object without constructing it.
+		/// Such converter defines static void Skip(ByteView&).
+		template <typename T>
+		struct SkipCondition
+		{
+			static constexpr bool value = Impl::SkipConcept::Skip<Utils::RemoveCVR<T>>::value;
+		};
+	}
+
 	/// Non owning container.
 	class ByteView : std::basic_string_view<ByteVector::value_type>
 	{
@@ -171,13 +215,44 @@ namespace FSecure
 			auto copy = *this;
 			BYTE_CONVERTER_TRY
 			{
-				auto current = ByteConverter<Utils::RemoveCVR<T>>::From(*this);
 				if constexpr (sizeof...(Ts) == 0)
-					return current;
-				else if constexpr (sizeof...(Ts) == 1)
-					return std::make_tuple(std::move(current), Read<Ts...>());
-				else
-					return std::tuple_cat(std::make_tuple(std::move(current)), Read<Ts...>());
+					return ReadOne<T>();
+				else // Braced initialization guarantees left to right evaluation order.
+					return std::tuple<ReadType<T>, ReadType<Ts>...>{ ReadOne<T>(), ReadOne<Ts>()... };
+			}
+			BYTE_CONVERTER_CATCH(...)
+			{
+				*this = copy;
+				BYTE_CONVERTER_THROW();
+			}
+		}
+
+		/// Read objects, allocating memory of containers from provided resource.
+		/// Containers using std::pmr::polymorphic_allocator, on any level of nesting, are constructed with resource.
+		/// @param resource. Memory resource, e.g. std::pmr::monotonic_buffer_resource serving as an arena for whole message.
+		/// @returns one type if Ts was empty, std::tuple with all types otherwise.
+		/// @see Utils::Container::MemoryResourceScope.
+		template<typename T, typename ...Ts, typename = decltype(FSecure::ByteConverter<Utils::RemoveCVR<T>>::From(std::declval<ByteView&>()))>
+		auto Read(std::pmr::memory_resource& resource)
+		{
+			auto scope = Utils::Container::MemoryResourceScope{ resource };
+			return Read<T, Ts...>();
+		}
+
+		/// Read objects into existing variables and move ByteView to position after parsed data.
+		/// Converters defining static void From(ByteView&, T&) reuse resources of existing object, e.g. capacity of containers.
+		/// Other types are assigned with result of regular Read.
+		/// @param objs. Objects to be overwritten.
+		/// @returns itself to allow chaining.
+		/// @note On exception ByteView is restored, but objects may be partially overwritten.
+		template<typename ...Ts>
+		ByteView& ReadInto(Ts& ...objs)
+		{
+			auto copy = *this;
+			BYTE_CONVERTER_TRY
+			{
+				(ReadIntoOne(objs), ...);
+				return *this;
 			}
 			BYTE_CONVERTER_CATCH(...)
 			{
@@ -185,6 +260,88 @@ namespace FSecure
 				BYTE_CONVERTER_THROW();
 			}
 		}
+
+		/// Move ByteView past serialized objects without constructing them.
+		/// Objects with size known at compile time are skipped in constant time. Converters defining static void Skip(ByteView&)
+		/// skip their data, e.g. by walking length prefixes. Other objects are read and discarded.
+		/// @tparam T. Mandatory type to be skipped.
+		/// @tparam Ts. Optional types to be skipped in one call.
+		/// @returns itself to allow chaining.
+		/// @throws std::out_of_range if there is not enough data. ByteView is restored.
+		template<typename T, typename ...Ts>
+		ByteView& Skip()
+		{
+			auto copy = *this;
+			BYTE_CONVERTER_TRY
+			{
+				SkipOne<T>();
+				(SkipOne<Ts>(), ...);
+				return *this;
+			}
+			BYTE_CONVERTER_CATCH(...)
+			{
+				*this = copy;
+				BYTE_CONVERTER_THROW();
+			}
+		}
+
+	private:
+		/// Move ByteView past one serialized object.
+		/// @tparam T. Type to be skipped.
+		template<typename T>
+		void SkipOne()
+		{
+			using Type = Utils::RemoveCVR<T>;
+			using Deduction = typename Detail::ConverterDeduction<Type>::FunctionSize;
+			if constexpr (Deduction::value == Deduction::type::compileTime)
+			{
+				if (ByteConverter<Type>::Size() > size())
+					BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Cannot read data from ByteView") });
+
+				remove_prefix(ByteConverter<Type>::Size());
+			}
+			else if constexpr (Detail::SkipCondition<Type>::value)
+			{
+				ByteConverter<Type>::Skip(*this);
+			}
+			else
+			{
+				[[maybe_unused]] auto discarded = ReadOne<Type>();
+			}
+		}
+
+		/// Read one object into existing variable.
+		/// @param obj. Object to be overwritten.
+		template<typename T>
+		void ReadIntoOne(T& obj)
+		{
+			if constexpr (Detail::ReadIntoCondition<T>::value)
+			{
+				BYTE_CONVERTER_METRICS_PROBE(read, Utils::RemoveCVR<T>, size());
+				ByteConverter<Utils::RemoveCVR<T>>::From(*this, obj);
+				BYTE_CONVERTER_METRICS_RECORD(size());
+			}
+			else
+			{
+				obj = ReadOne<T>();
+			}
+		}
+
+		/// Type returned by reading T from ByteView.
+		template <typename T>
+		using ReadType = decltype(FSecure::ByteConverter<Utils::RemoveCVR<T>>::From(std::declval<ByteView&>()));
+
+		/// Read one object and move ByteView to position after parsed data.
+		/// @tparam T. Type to be retrieved from ByteView.
+		/// @returns object created by ByteConverter<T>::From.
+		template<typename T>
+		ReadType<T> ReadOne()
+		{
+			BYTE_CONVERTER_METRICS_PROBE(read, Utils::RemoveCVR<T>, size());
+			auto ret = ByteConverter<Utils::RemoveCVR<T>>::From(*this);
+			BYTE_CONVERTER_METRICS_RECORD(size());
+			return ret;
+		}
 	};
 
 	/// Helper class for Reading data from ByteView.
@@ -202,6 +359,7 @@ namespace FSecure
 		{}
 
 		/// Read each of arguments from ByteView.
+		/// Arguments are assigned with newly read objects. Use ByteView::ReadInto to reuse their resources instead.
 		/// @param ts, arguments to tie, and read.
 		template <typename ...Ts>
 		void Read(Ts&... ts)
@@ -0,0 +1,358 @@
+#pragma once
+
+#include "ByteConverter.h"
+
+#include <unordered_map>
+
+namespace FSecure
+{
+	/// Binary delta between two buffers, e.g. consecutive serialized snapshots of the same state.
+	/// Delta is serialized with ByteVector, and rebuilds target when applied to base it was created from.
+	/// @code auto delta = Delta::Encode(previous, current); auto rebuilt = Delta::Apply(previous, delta); @endcode
+	class Delta
+	{
+	public:
+		/// Create delta.
+		/// Buffers of the same size are compared byte by byte, and delta lists changed ranges. This is the case of snapshots whose fixed size fields changed.
+		/// Otherwise blocks of base are indexed by rolling hash, and target is described as copies of base and inserted data.
+		/// @param base. Buffer known to recipient.
+		/// @param target. Buffer to be rebuilt by recipient.
+		/// @param blockSize. Length of matched blocks. Shorter blocks find more matches, but use more memory.
+		/// @return serialized delta.
+		/// @throws std::out_of_range if buffer is larger than uint32_t can express.
+		static ByteVector Encode(ByteView base, ByteView target, size_t blockSize = 16)
+		{
+			if (base.size() > (std::numeric_limits<uint32_t>::max)() || target.size() > (std::numeric_limits<uint32_t>::max)())
+				BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Delta buffer exceeds maximal size") });
+
+			if (base.size() == target.size())
+			{
+				auto ret = EncodeChanges(base, target);
+				if (ret.size() - HeaderSize <= target.size() / 2)
+					return ret;
+			}
+
+			return EncodeMatches(base, target, (std::max)(blockSize, size_t{ 4 }));
+		}
+
+		/// Rebuild target.
+		/// @param base. Buffer used to create delta.
+		/// @param delta. Result of Encode.
+		/// @return target buffer.
+		/// @throws std::runtime_error if delta was created from different base.
+		/// @throws std::out_of_range if delta is corrupted.
+		static ByteVector Apply(ByteView base, ByteView delta)
+		{
+			auto [format, baseSize, baseHash, targetSize] = delta.Read<uint8_t, uint32_t, uint32_t, uint32_t>();
+			if (baseSize != base.size() || baseHash != Hash(base))
+				BYTE_CONVERTER_THROW(std::runtime_error{ OBF("Delta was created from different base") });
+
+			auto ret = ByteVector{};
+			ret.reserve(targetSize);
+			if (format == Format::changes)
+				ApplyChanges(base, delta, ret);
+			else if (format == Format::matches)
+				ApplyMatches(base, delta, ret);
+			else
+				BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Unknown delta format") });
+
+			if (ret.size() != targetSize)
+				BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Delta does not rebuild target") });
+
+			return ret;
+		}
+
+	private:
+		/// Kinds of delta.
+		struct Format
+		{
+			/// Sequence of uint32_t offset and ByteView, replacing bytes of base of the same size.
+			static constexpr uint8_t changes = 0;
+
+			/// Sequence of operations building target from copies of base and inserted data.
+			static constexpr uint8_t matches = 1;
+		};
+
+		/// Operations of Format::matches.
+		struct Operation
+		{
+			/// uint32_t offset and uint32_t length of range of base.
+			static constexpr uint8_t copy = 0;
+
+			/// ByteView with inserted data.
+			static constexpr uint8_t insert = 1;
+		};
+
+		/// Size of format, base size, base hash and target size.
+		static constexpr size_t HeaderSize = sizeof(uint8_t) + 3 * sizeof(uint32_t);
+
+		/// Unchanged ranges shorter than this are included in surrounding change, because new change costs more.
+		static constexpr size_t MinimalGap = sizeof(uint32_t) * 2;
+
+		/// Multiplier of rolling hash.
+		static constexpr uint32_t Prime = 16777619u;
+
+		/// Maximal number of blocks with equal hash compared with target.
+		static constexpr size_t MaxCandidates = 8;
+
+		/// Matches shorter than this number of blocks are compared with matches starting within this number of blocks.
+		static constexpr size_t LongMatch = 4;
+
+		/// End of chain of blocks with equal hash.
+		static constexpr uint32_t NoBlock = (std::numeric_limits<uint32_t>::max)();
+
+		/// Start delta.
+		/// @param format. Kind of delta.
+		/// @param base. Buffer known to recipient.
+		/// @param target. Buffer to be rebuilt by recipient.
+		static ByteVector Header(uint8_t format, ByteView base, ByteView target)
+		{
+			return ByteVector::Create(format, static_cast<uint32_t>(base.size()), Hash(base), static_cast<uint32_t>(target.size()));
+		}
+
+		/// Compute FNV-1a hash of buffer, detecting delta applied to wrong base.
+		/// @param data. Hashed buffer.
+		static uint32_t Hash(ByteView data)
+		{
+			auto ret = 2166136261u;
+			for (auto byte : data)
+				ret = (ret ^ byte) * Prime;
+
+			return ret;
+		}
+
+		/// Create delta of buffers of the same size, listing changed ranges.
+		/// @param base. Buffer known to recipient.
+		/// @param target. Buffer to be rebuilt by recipient.
+		static ByteVector EncodeChanges(ByteView base, ByteView target)
+		{
+			auto ret = Header(Format::changes, base, target);
+			auto size = target.size();
+			auto i = size_t{ 0 };
+			while (i < size)
+			{
+				if (base[i] == target[i])
+				{
+					++i;
+					continue;
+				}
+
+				auto begin = i;
+				auto end = i + 1;
+				for (auto gap = size_t{ 0 }; end + gap < size && gap < MinimalGap; )
+				{
+					if (base[end + gap] != target[end + gap])
+					{
+						end += gap + 1;
+						gap = 0;
+					}
+					else
+					{
+						++gap;
+					}
+				}
+
+				ret.Write(static_cast<uint32_t>(begin), target.SubString(begin, end - begin));
+				i = end;
+			}
+
+			return ret;
+		}
+
+		/// Apply delta of Format::changes.
+		/// @param base. Buffer used to create delta.
+		/// @param delta. Operations following header.
+		/// @param target. Buffer to be filled.
+		static void ApplyChanges(ByteView base, ByteView delta, ByteVector& target)
+		{
+			target = base;
+			while (!delta.empty())
+			{
+				auto [offset, data] = delta.Read<uint32_t, ByteView>();
+				if (offset > target.size() || target.size() - offset < data.size())
+					BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Delta change is out of base") });
+
+				memcpy(target.data() + offset, data.data(), data.size());
+			}
+		}
+
+		/// Create delta by matching blocks of base in target.
+		/// @param base. Buffer known to recipient.
+		/// @param target. Buffer to be rebuilt by recipient.
+		/// @param blockSize. Length of matched blocks.
+		static ByteVector EncodeMatches(ByteView base, ByteView target, size_t blockSize)
+		{
+			auto ret = Header(Format::matches, base, target);
+			if (target.size() < blockSize || base.size() < blockSize)
+			{
+				Insert(ret, target);
+				return ret;
+			}
+
+			// Blocks of base are indexed without overlapping. Blocks with equal hash are chained, the latest first.
+			auto heads = std::unordered_map<uint32_t, uint32_t>{};
+			auto chain = std::vector<uint32_t>(base.size() / blockSize, NoBlock);
+			heads.reserve(chain.size());
+			for (auto block = uint32_t{ 0 }; block < chain.size(); ++block)
+			{
+				auto [head, inserted] = heads.emplace(RollingHash(base.SubString(block * blockSize, blockSize)), block);
+				if (!inserted)
+					chain[block] = std::exchange(head->second, block);
+			}
+
+			auto outgoing = uint32_t{ 1 };
+			for (auto i = size_t{ 1 }; i < blockSize; ++i)
+				outgoing *= Prime;
+
+			auto pending = size_t{ 0 };
+			auto continuation = size_t{ 0 };
+			auto find = [&](size_t position, uint32_t hash)
+			{
+				// Data following previous copy is the most likely match, e.g. after changed byte.
+				auto best = Match{};
+				auto expected = continuation + (position - pending);
+				if (expected + blockSize <= base.size())
+					best = Extend(base, target, expected, position, pending, blockSize);
+
+				auto found = heads.find(hash);
+				auto block = found != heads.end() ? found->second : NoBlock;
+				for (auto candidates = size_t{ 0 }; block != NoBlock && candidates < MaxCandidates; block = chain[block], ++candidates)
+				{
+					auto match = Extend(base, target, size_t{ block } * blockSize, position, pending, blockSize);
+					if (match.m_Length > best.m_Length)
+						best = match;
+				}
+
+				return best;
+			};
+
+			auto roll = [&](uint32_t hash, size_t position)
+			{
+				return (hash - target[position] * outgoing) * Prime + target[position + blockSize];
+			};
+
+			auto position = size_t{ 0 };
+			auto hash = RollingHash(target.SubString(0, blockSize));
+			while (position + blockSize <= target.size())
+			{
+				auto best = find(position, hash);
+				if (!best.m_Length)
+				{
+					if (position + blockSize < target.size())
+						hash = roll(hash, position);
+
+					++position;
+					continue;
+				}
+
+				// Short match may be data repeated in many places. Following positions are checked for longer one, before short match is taken.
+				auto ahead = hash;
+				for (auto next = position; best.m_Length < LongMatch * blockSize && next < position + LongMatch * blockSize && next + blockSize < target.size(); ++next)
+				{
+					ahead = roll(ahead, next);
+					auto match = find(next + 1, ahead);
+					if (match.m_Length > best.m_Length)
+						best = match;
+				}
+
+				Insert(ret, target.SubString(pending, best.m_Target - pending));
+				ret.Write(Operation::copy, static_cast<uint32_t>(best.m_Source), static_cast<uint32_t>(best.m_Length));
+				position = best.m_Target + best.m_Length;
+				pending = position;
+				continuation = best.m_Source + best.m_Length;
+				if (position + blockSize <= target.size())
+					hash = RollingHash(target.SubString(position, blockSize));
+			}
+
+			Insert(ret, target.SubString(pending));
+			return ret;
+		}
+
+		/// Range of base found in target.
+		struct Match
+		{
+			/// Position in base.
+			size_t m_Source = 0;
+
+			/// Position in target.
+			size_t m_Target = 0;
+
+			/// Number of matching bytes, or zero if block does not match.
+			size_t m_Length = 0;
+		};
+
+		/// Check if block of base matches target, and extend match forward, and backward into data not yet written to delta.
+		/// @param base. Buffer known to recipient.
+		/// @param target. Buffer to be rebuilt by recipient.
+		/// @param source. Position of candidate block in base.
+		/// @param position. Position of block in target.
+		/// @param pending. Position of the first byte of target not yet written to delta.
+		/// @param blockSize. Length of matched blocks.
+		static Match Extend(ByteView base, ByteView target, size_t source, size_t position, size_t pending, size_t blockSize)
+		{
+			if (base[source] != target[position] || memcmp(base.data() + source, target.data() + position, blockSize))
+				return {};
+
+			auto length = blockSize;
+			while (source + length < base.size() && position + length < target.size() && base[source + length] == target[position + length])
+				++length;
+
+			while (source && position > pending && base[source - 1] == target[position - 1])
+			{
+				--source;
+				--position;
+				++length;
+			}
+
+			return { source, position, length };
+		}
+
+		/// Apply delta of Format::matches.
+		/// @param base. Buffer used to create delta.
+		/// @param delta. Operations following header.
+		/// @param target. Buffer to be filled.
+		static void ApplyMatches(ByteView base, ByteView delta, ByteVector& target)
+		{
+			while (!delta.empty())
+			{
+				auto operation = delta.Read<uint8_t>();
+				if (operation == Operation::copy)
+				{
+					auto [offset, length] = delta.Read<uint32_t, uint32_t>();
+					if (offset > base.size() || base.size() - offset < length)
+						BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Delta copy is out of base") });
+
+					target.Concat(base.SubString(offset, length));
+				}
+				else if (operation == Operation::insert)
+				{
+					target.Concat(delta.Read<ByteView>());
+				}
+				else
+				{
+					BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Unknown delta operation") });
+				}
+			}
+		}
+
+		/// Append insert operation, if there is data to be inserted.
+		/// @param delta. Delta to be expanded.
+		/// @param data. Inserted data.
+		static void Insert(ByteVector& delta, ByteView data)
+		{
+			if (!data.empty())
+				delta.Write(Operation::insert, data);
+		}
+
+		/// Compute polynomial hash of block, that can be rolled by one byte.
+		/// @param block. Hashed data.
+		static uint32_t RollingHash(ByteView block)
+		{
+			auto ret = uint32_t{ 0 };
+			for (auto byte : block)
+				ret = ret * Prime + byte;
+
+			return ret;
+		}
+	};
+}
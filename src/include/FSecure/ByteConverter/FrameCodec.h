@@ -0,0 +1,275 @@
+#pragma once
+
+#include "ByteConverter.h"
+
+#include <deque>
+
+#if defined(__unix__) || defined(__APPLE__)
+#	include <cerrno>
+#	include <climits>
+#	include <system_error>
+#	include <sys/uio.h>
+#	include <unistd.h>
+#	define BYTE_CONVERTER_HAS_POSIX_IO 1
+#endif
+
+namespace FSecure
+{
+	/// Splits stream of bytes into frames prefixed with uint32_t length.
+	/// Frame is serialized the same way as ByteView, so it can be produced by ByteVector::Write(ByteView), or FrameEncoder.
+	/// Frames received in one chunk are passed to consumer without copying. Only frames split between chunks are assembled in internal buffer.
+	/// @code decoder.Feed(chunk, [](ByteView frame) { Handle(frame); }); @endcode
+	class FrameDecoder
+	{
+	public:
+		/// Size of length prefix.
+		static constexpr size_t HeaderSize = sizeof(uint32_t);
+
+		/// Create decoder.
+		/// @param maxFrameSize. Limit of frame size. Larger frames are treated as corrupted stream.
+		/// @param receiveSize. Size of buffer used by ReadFrom.
+		explicit FrameDecoder(size_t maxFrameSize = 16 * 1024 * 1024, size_t receiveSize = 64 * 1024)
+			: m_MaxFrameSize{ maxFrameSize }
+			, m_Receive(receiveSize)
+		{
+		}
+
+		/// Process chunk of stream.
+		/// Views passed to consumer are valid only during call. If consumer throws, the rest of chunk is dropped.
+		/// @param chunk. Next part of stream.
+		/// @param consumer. Callable taking ByteView, called for each complete frame.
+		/// @return number of complete frames.
+		/// @throws std::out_of_range if frame exceeds maxFrameSize. Stream cannot be decoded further.
+		template <typename Consumer>
+		size_t Feed(ByteView chunk, Consumer&& consumer)
+		{
+			auto count = size_t{ 0 };
+			if (!m_Partial.empty())
+			{
+				if (!Complete(chunk))
+					return count;
+
+				// Buffer is moved out, so frame is dropped even if consumer throws.
+				auto frame = std::move(m_Partial);
+				++count;
+				consumer(ByteView{ frame }.SubString(HeaderSize));
+				frame.clear();
+				m_Partial = std::move(frame);
+			}
+
+			while (chunk.size() >= HeaderSize)
+			{
+				auto length = Length(chunk);
+				if (chunk.size() - HeaderSize < length)
+					break;
+
+				++count;
+				auto frame = chunk.SubString(HeaderSize, length);
+				chunk.remove_prefix(HeaderSize + length);
+				consumer(frame);
+			}
+
+			if (!chunk.empty())
+				m_Partial.Concat(chunk);
+
+			return count;
+		}
+
+		/// Get number of bytes of incomplete frame.
+		size_t Pending() const
+		{
+			return m_Partial.size();
+		}
+
+#if defined(BYTE_CONVERTER_HAS_POSIX_IO)
+		/// Read available data from descriptor and process it.
+		/// @param descriptor. Stream socket, or pipe.
+		/// @param consumer. Callable taking ByteView, called for each complete frame.
+		/// @return number of bytes read, 0 at the end of stream, or empty std::optional if read would block, or was interrupted.
+		/// @throws std::system_error if read fails.
+		template <typename Consumer>
+		std::optional<size_t> ReadFrom(int descriptor, Consumer&& consumer)
+		{
+			auto received = read(descriptor, m_Receive.data(), m_Receive.size());
+			if (received < 0)
+			{
+				if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+					return {};
+
+				BYTE_CONVERTER_THROW(std::system_error{ errno, std::system_category(), OBF("read") });
+			}
+
+			Feed(ByteView{ m_Receive.data(), static_cast<size_t>(received) }, std::forward<Consumer>(consumer));
+			return static_cast<size_t>(received);
+		}
+#endif
+
+	private:
+		/// Move data from chunk to incomplete frame.
+		/// @param chunk. Next part of stream. Used bytes are removed.
+		/// @return true if frame is complete.
+		bool Complete(ByteView& chunk)
+		{
+			if (m_Partial.size() < HeaderSize)
+			{
+				auto header = chunk.SubString(0, HeaderSize - m_Partial.size());
+				m_Partial.Concat(header);
+				chunk.remove_prefix(header.size());
+				if (m_Partial.size() < HeaderSize)
+					return false;
+			}
+
+			auto length = Length(m_Partial);
+			auto body = chunk.SubString(0, HeaderSize + length - m_Partial.size());
+			m_Partial.Concat(body);
+			chunk.remove_prefix(body.size());
+			return m_Partial.size() == HeaderSize + length;
+		}
+
+		/// Read length prefix.
+		/// @param header. Data starting with length prefix.
+		/// @return size of frame.
+		/// @throws std::out_of_range if frame exceeds limit.
+		size_t Length(ByteView header) const
+		{
+			auto length = header.Read<uint32_t>();
+			if (length > m_MaxFrameSize)
+				BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Frame exceeds maximal size") });
+
+			return length;
+		}
+
+		/// Limit of frame size.
+		size_t m_MaxFrameSize;
+
+		/// Frame split between chunks.
+		ByteVector m_Partial;
+
+		/// Buffer for ReadFrom.
+		std::vector<uint8_t> m_Receive;
+	};
+
+	/// Queues frames prefixed with uint32_t length, and writes them to stream.
+	/// Frames are not copied, and many of them are written with single writev call.
+	/// @code encoder.Write(header, body); encoder.Push(std::move(frame)); encoder.Flush(socket); @endcode
+	class FrameEncoder
+	{
+	public:
+		/// Queue frame. Pass rvalue to avoid copying.
+		/// @param frame. Content of frame.
+		/// @return itself to allow chaining.
+		/// @throws std::out_of_range if frame is larger than uint32_t can express.
+		FrameEncoder& Push(ByteVector frame)
+		{
+			if (frame.size() > (std::numeric_limits<uint32_t>::max)())
+				BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Frame exceeds maximal size") });
+
+			m_Pending += FrameDecoder::HeaderSize + frame.size();
+			m_Frames.push_back({ static_cast<uint32_t>(frame.size()), std::move(frame) });
+			return *this;
+		}
+
+		/// Serialize objects into new frame.
+		/// @param args. Objects to be stored.
+		/// @return itself to allow chaining.
+		template <typename T, typename ...Ts>
+		FrameEncoder& Write(T const& arg, Ts const& ...args)
+		{
+			return Push(ByteVector::Create(arg, args...));
+		}
+
+		/// Get number of bytes waiting to be written.
+		size_t Pending() const
+		{
+			return m_Pending;
+		}
+
+		/// Get number of frames waiting to be written. Partially written frame is included.
+		size_t Frames() const
+		{
+			return m_Frames.size();
+		}
+
+#if defined(BYTE_CONVERTER_HAS_POSIX_IO)
+		/// Write queued frames, coalescing them into writev calls.
+		/// @param descriptor. Stream socket, or pipe.
+		/// @return true if all frames were written, false if write would block, or was interrupted.
+		/// @throws std::system_error if write fails.
+		bool Flush(int descriptor)
+		{
+			iovec vectors[MaxVectors];
+			while (!m_Frames.empty())
+			{
+				auto count = 0;
+				auto skip = m_Written;
+				for (auto& frame : m_Frames)
+				{
+					if (count + 2 > MaxVectors)
+						break;
+
+					for (auto [data, size] : { std::pair{ static_cast<void*>(&frame.m_Header), FrameDecoder::HeaderSize }, std::pair{ static_cast<void*>(frame.m_Payload.data()), frame.m_Payload.size() } })
+					{
+						auto used = (std::min)(skip, size);
+						skip -= used;
+						if (size > used)
+							vectors[count++] = { static_cast<uint8_t*>(data) + used, size - used };
+					}
+				}
+
+				auto written = writev(descriptor, vectors, count);
+				if (written < 0)
+				{
+					if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+						return false;
+
+					BYTE_CONVERTER_THROW(std::system_error{ errno, std::system_category(), OBF("writev") });
+				}
+
+				Consume(static_cast<size_t>(written));
+			}
+
+			return true;
+		}
+#endif
+
+	private:
+		/// Queued frame.
+		struct Frame
+		{
+			/// Length prefix.
+			uint32_t m_Header;
+
+			/// Content of frame.
+			ByteVector m_Payload;
+		};
+
+#if defined(BYTE_CONVERTER_HAS_POSIX_IO)
+		/// Maximal number of buffers passed to one writev call.
+		static constexpr int MaxVectors = IOV_MAX < 1024 ? IOV_MAX : 1024;
+#endif
+
+		/// Remove written bytes from queue.
+		/// @param written. Number of bytes written.
+		void Consume(size_t written)
+		{
+			m_Pending -= written;
+			written += m_Written;
+			while (!m_Frames.empty() && written >= FrameDecoder::HeaderSize + m_Frames.front().m_Payload.size())
+			{
+				written -= FrameDecoder::HeaderSize + m_Frames.front().m_Payload.size();
+				m_Frames.pop_front();
+			}
+
+			m_Written = written;
+		}
+
+		/// Queued frames.
+		std::deque<Frame> m_Frames;
+
+		/// Number of already written bytes of the first frame.
+		size_t m_Written = 0;
+
+		/// Number of bytes waiting to be written.
+		size_t m_Pending = 0;
+	};
+}
@@ -0,0 +1,368 @@
+#pragma once
+
+#include "ByteSpan.h"
+
+#include <atomic>
+#include <memory>
+#include <new>
+
+namespace FSecure
+{
+	/// Lock-free ring buffer of serialized frames with one consumer.
+	/// Producers reserve space, serialize directly into the ring, and commit. Consumer reads frames in place as ByteView, and releases them.
+	/// Frames become visible in order of reservation. Consumer stops at the first frame that was reserved, but not committed yet.
+	/// Frame that does not fit before the end of memory is preceded by padding, and placed at the beginning.
+	/// All state is stored in memory of the ring, so it can be placed in memory shared between processes.
+	/// @code if (auto reservation = ring.Reserve(ByteVector::Size(message))) { reservation->Write(message); ring.Commit(*reservation); } @endcode
+	/// @tparam MultiProducer. Allow concurrent calls of Reserve. Reservation uses compare-and-swap instead of plain store.
+	template <bool MultiProducer>
+	class FrameRing
+	{
+		/// Shared state, placed before frames.
+		struct Control
+		{
+			/// Position after the last reserved frame.
+			alignas(64) std::atomic<uint64_t> m_Reserved;
+
+			/// Position after the last released frame.
+			alignas(64) std::atomic<uint64_t> m_Released;
+		};
+
+		/// Alignment of frames.
+		static constexpr size_t Alignment = 8;
+
+		/// Frame header. First word is zero until frame is committed, then contains length of slot. Second word contains size of data.
+		static constexpr size_t HeaderSize = 2 * sizeof(uint32_t);
+
+		/// Bit of first word of header, marking slot without data.
+		static constexpr uint32_t PaddingBit = 0x80000000u;
+
+		static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free, "FrameRing requires lock-free atomics");
+
+	public:
+		/// Space reserved for one frame.
+		/// Data is written with Write, or through Span, and published with FrameRing::Commit.
+		class Reservation
+		{
+		public:
+			/// Write content of provided objects after already written data.
+			/// @see ByteSpan::Write.
+			/// @return itself to allow chaining.
+			template <typename ...Ts>
+			Reservation& Write(Ts const& ...args)
+			{
+				m_Span.Write(args...);
+				return *this;
+			}
+
+			/// Get memory of frame. Number of bytes written to span is size of committed frame.
+			ByteSpan& Span()
+			{
+				return m_Span;
+			}
+
+		private:
+			/// Create reservation.
+			/// @param position. Position of slot.
+			/// @param slot. Length of slot, with header.
+			/// @param data. Memory of frame.
+			/// @param capacity. Size of memory of frame.
+			Reservation(uint64_t position, uint32_t slot, uint8_t* data, size_t capacity)
+				: m_Position{ position }
+				, m_Slot{ slot }
+				, m_Span{ data, capacity }
+			{
+			}
+
+			/// Position of slot.
+			uint64_t m_Position;
+
+			/// Length of slot, with header.
+			uint32_t m_Slot;
+
+			/// Memory of frame.
+			ByteSpan m_Span;
+
+			/// Declaration of friendship.
+			friend class FrameRing;
+		};
+
+		/// Get size of memory required for external memory constructor.
+		/// @param capacity. Space for frames. Must be power of two.
+		static constexpr size_t RequiredMemory(size_t capacity)
+		{
+			return sizeof(Control) + capacity;
+		}
+
+		/// Create ring with own memory.
+		/// @param capacity. Space for frames, with headers. Must be power of two.
+		/// @throws std::invalid_argument if capacity is not power of two.
+		explicit FrameRing(size_t capacity)
+			: m_Memory{ new uint8_t[RequiredMemory(capacity) + alignof(Control)] }
+		{
+			void* memory = m_Memory.get();
+			auto size = RequiredMemory(capacity) + alignof(Control);
+			Attach(static_cast<uint8_t*>(std::align(alignof(Control), RequiredMemory(capacity), memory, size)), capacity, true);
+		}
+
+		/// Create ring in external memory, e.g. shared between processes.
+		/// @param memory. At least RequiredMemory(capacity) bytes, aligned to 64 bytes. Must outlive the ring.
+		/// @param capacity. Space for frames, with headers. Must be power of two.
+		/// @param initialize. Reset state and memory. Exactly one of rings sharing memory must initialize it, before others use it.
+		/// @throws std::invalid_argument if capacity is not power of two, or memory is not aligned.
+		FrameRing(void* memory, size_t capacity, bool initialize)
+		{
+			if (reinterpret_cast<uintptr_t>(memory) % alignof(Control))
+				BYTE_CONVERTER_THROW(std::invalid_argument{ OBF(": FrameRing memory is not aligned") });
+
+			Attach(static_cast<uint8_t*>(memory), capacity, initialize);
+		}
+
+		FrameRing(FrameRing const&) = delete;
+		FrameRing& operator=(FrameRing const&) = delete;
+
+		/// Get space for frames.
+		size_t Capacity() const
+		{
+			return m_Mask + 1;
+		}
+
+		/// Get the largest frame that can be reserved.
+		/// Frames are limited to half of capacity, so that frame with padding always fits into empty ring.
+		size_t MaxFrameSize() const
+		{
+			return (std::min<size_t>)(Capacity() / 2, PaddingBit) - HeaderSize;
+		}
+
+		/// Reserve space for frame.
+		/// @param size. Maximal size of frame.
+		/// @return reservation, or empty std::optional if there is not enough free space.
+		/// @throws std::invalid_argument if frame would never fit.
+		std::optional<Reservation> Reserve(size_t size)
+		{
+			if (size > MaxFrameSize())
+				BYTE_CONVERTER_THROW(std::invalid_argument{ OBF(": Frame is larger than FrameRing") });
+
+			auto slot = static_cast<uint32_t>((HeaderSize + size + Alignment - 1) & ~(Alignment - 1));
+			auto position = m_Control->m_Reserved.load(std::memory_order_relaxed);
+			auto padding = size_t{ 0 };
+			while (true)
+			{
+				auto offset = position & m_Mask;
+				padding = offset + slot > Capacity() ? Capacity() - offset : 0;
+				auto end = position + padding + slot;
+				auto released = m_Control->m_Released.load(std::memory_order_acquire);
+				if (end - released > Capacity())
+				{
+					// Relaxed load of m_Reserved can be older than m_Released. Such position is behind consumer, not a full ring.
+					if (static_cast<int64_t>(released - position) > 0)
+					{
+						position = m_Control->m_Reserved.load(std::memory_order_relaxed);
+						continue;
+					}
+
+					return {};
+				}
+
+				if constexpr (MultiProducer)
+				{
+					if (m_Control->m_Reserved.compare_exchange_weak(position, end, std::memory_order_relaxed))
+						break;
+				}
+				else
+				{
+					m_Control->m_Reserved.store(end, std::memory_order_relaxed);
+					break;
+				}
+			}
+
+			if (padding)
+				Publish(position, static_cast<uint32_t>(padding) | PaddingBit, 0);
+
+			position += padding;
+			return Reservation{ position, slot, Data(position) + HeaderSize, slot - HeaderSize };
+		}
+
+		/// Publish frame. Size of frame is number of bytes written to reservation.
+		/// @param reservation. Frame to be published.
+		void Commit(Reservation const& reservation)
+		{
+			Publish(reservation.m_Position, reservation.m_Slot, static_cast<uint32_t>(reservation.m_Span.size()));
+		}
+
+		/// Publish frames together.
+		/// Frames are published from the last one, so consumer sees consecutive frames of batch at once.
+		/// @param first. Iterator to the first reservation.
+		/// @param last. Iterator past the last reservation.
+		template <typename Iterator>
+		void Commit(Iterator first, Iterator last)
+		{
+			while (first != last)
+				Commit(*--last);
+		}
+
+		/// Give up reservation. Slot is skipped by consumer.
+		/// @param reservation. Frame not to be published.
+		void Abandon(Reservation const& reservation)
+		{
+			Publish(reservation.m_Position, reservation.m_Slot | PaddingBit, 0);
+		}
+
+		/// Serialize objects into one frame.
+		/// @param args. Objects to be stored.
+		/// @return false if there is not enough free space.
+		template <typename T, typename ...Ts>
+		bool TryWrite(T const& arg, Ts const& ...args)
+		{
+			auto reservation = Reserve(ByteVector::Size(arg, args...));
+			if (!reservation)
+				return false;
+
+			BYTE_CONVERTER_TRY
+			{
+				reservation->Write(arg, args...);
+			}
+			BYTE_CONVERTER_CATCH (...)
+			{
+				Abandon(*reservation);
+				BYTE_CONVERTER_THROW();
+			}
+
+			Commit(*reservation);
+			return true;
+		}
+
+		/// Get next committed frame. Only one thread can consume frames.
+		/// Frame stays valid until Release is called.
+		/// @return view of frame, or empty std::optional if next frame was not committed yet.
+		std::optional<ByteView> Next()
+		{
+			while (true)
+			{
+				auto header = Data(m_Read);
+				auto state = Header(header).load(std::memory_order_acquire);
+				if (!state)
+					return {};
+
+				// Full ring ends where it begins, so header of frame is cleared before it is passed.
+				Header(header).store(0, std::memory_order_relaxed);
+				m_Read += state & ~PaddingBit;
+				if (!(state & PaddingBit))
+					return ByteView{ header + HeaderSize, *reinterpret_cast<uint32_t const*>(header + sizeof(uint32_t)) };
+			}
+		}
+
+		/// Release all frames returned by Next, making their space available for producers.
+		/// Released memory is zeroed, so data of previous lap is never mistaken for header of committed frame.
+		void Release()
+		{
+			auto released = m_Control->m_Released.load(std::memory_order_relaxed);
+			auto length = static_cast<size_t>(m_Read - released);
+			auto tail = (std::min)(length, Capacity() - (released & m_Mask));
+			memset(Data(released), 0, tail);
+			memset(m_Frames, 0, length - tail);
+			m_Control->m_Released.store(m_Read, std::memory_order_release);
+		}
+
+		/// Process available frames and release them together.
+		/// @param consumer. Callable taking ByteView.
+		/// @param maxFrames. Maximal number of processed frames.
+		/// @return number of processed frames.
+		template <typename Consumer>
+		size_t Consume(Consumer&& consumer, size_t maxFrames = static_cast<size_t>(-1))
+		{
+			auto count = size_t{ 0 };
+			for (; count < maxFrames; ++count)
+			{
+				auto frame = Next();
+				if (!frame)
+					break;
+
+				consumer(*frame);
+			}
+
+			if (count)
+				Release();
+
+			return count;
+		}
+
+		/// Check if next frame, or padding was committed. Used only by consumer.
+		/// @return true if Next may return frame. Next can still fail, if only padding was committed.
+		bool HasFrame() const
+		{
+			return Header(Data(m_Read)).load(std::memory_order_acquire) != 0;
+		}
+
+		/// Check if there are no frames reserved, or waiting for release.
+		bool Empty() const
+		{
+			return m_Control->m_Reserved.load(std::memory_order_acquire) == m_Control->m_Released.load(std::memory_order_acquire);
+		}
+
+	private:
+		/// Bind ring to memory.
+		/// @param memory. Memory aligned for Control.
+		/// @param capacity. Space for frames.
+		/// @param initialize. Reset state and memory.
+		void Attach(uint8_t* memory, size_t capacity, bool initialize)
+		{
+			if (capacity < 2 * HeaderSize || (capacity & (capacity - 1)))
+				BYTE_CONVERTER_THROW(std::invalid_argument{ OBF(": FrameRing capacity must be power of two") });
+
+			m_Mask = capacity - 1;
+			m_Frames = memory + sizeof(Control);
+			if (initialize)
+			{
+				m_Control = new (memory) Control{};
+				memset(m_Frames, 0, capacity);
+			}
+			else
+			{
+				m_Control = std::launder(reinterpret_cast<Control*>(memory));
+			}
+
+			m_Read = m_Control->m_Released.load(std::memory_order_acquire);
+		}
+
+		/// Get memory of slot.
+		/// @param position. Position of slot.
+		uint8_t* Data(uint64_t position) const
+		{
+			return m_Frames + (position & m_Mask);
+		}
+
+		/// Get first word of header.
+		/// @param header. Memory of header.
+		static std::atomic<uint32_t>& Header(uint8_t* header)
+		{
+			return *reinterpret_cast<std::atomic<uint32_t>*>(header);
+		}
+
+		/// Fill header of slot, making it visible for consumer.
+		/// @param position. Position of slot.
+		/// @param state. First word of header.
+		/// @param size. Size of data.
+		void Publish(uint64_t position, uint32_t state, uint32_t size)
+		{
+			auto header = Data(position);
+			memcpy(header + sizeof(uint32_t), &size, sizeof(size));
+			Header(header).store(state, std::memory_order_release);
+		}
+
+		/// Own memory, if ring was not created in external memory.
+		std::unique_ptr<uint8_t[]> m_Memory;
+
+		/// Shared state.
+		Control* m_Control = nullptr;
+
+		/// Beginning of memory for frames.
+		uint8_t* m_Frames = nullptr;
+
+		/// Capacity - 1.
+		size_t m_Mask = 0;
+
+		/// Position of next frame returned by Next. Used only by consumer.
+		uint64_t m_Read = 0;
+	};
+}
@@ -0,0 +1,295 @@
+#pragma once
+
+/// Per-type serialization metrics.
+/// Define BYTE_CONVERTER_METRICS to record number of calls, bytes and time spent in ByteVector::Store and ByteView::Read for each type.
+/// When BYTE_CONVERTER_METRICS is not defined, hooks expand to nothing.
+/// @note All translation units of a program must agree on BYTE_CONVERTER_METRICS.
+#if defined(BYTE_CONVERTER_METRICS)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Maximal number of distinct types that can be recorded. Types registered above this limit are ignored.
+#ifndef BYTE_CONVERTER_METRICS_MAX_TYPES
+#	define BYTE_CONVERTER_METRICS_MAX_TYPES 256
+#endif
+
+namespace FSecure::Metrics
+{
+	/// Direction of recorded operation.
+	enum class Direction
+	{
+		write,
+		read,
+	};
+
+	/// Statistics of one type, summed over all threads.
+	/// Time is inclusive, so it contains time spent on members of the type.
+	struct TypeStatistics
+	{
+		std::string m_Type;
+		std::uint64_t m_Writes = 0;
+		std::uint64_t m_BytesWritten = 0;
+		std::chrono::nanoseconds m_WriteTime{ 0 };
+		std::uint64_t m_Reads = 0;
+		std::uint64_t m_BytesRead = 0;
+		std::chrono::nanoseconds m_ReadTime{ 0 };
+	};
+
+	/// Namespace for internal implementation.
+	namespace Detail
+	{
+		/// Maximal number of types.
+		constexpr std::size_t MaxTypes = BYTE_CONVERTER_METRICS_MAX_TYPES;
+
+		/// Index of counter in Counters::m_Values.
+		enum Counter
+		{
+			writes,
+			bytesWritten,
+			writeTime,
+			reads,
+			bytesRead,
+			readTime,
+			count,
+		};
+
+		/// Counters of one thread. Written only by owning thread, read by any thread taking snapshot.
+		/// Blocks are never freed, so counts of finished threads are kept. Block of finished thread is taken over by next started thread,
+		/// so number of blocks does not exceed number of threads running at the same time.
+		struct Counters
+		{
+			std::atomic<std::uint64_t> m_Values[MaxTypes][Counter::count] = {};
+
+			/// Value of g_Epoch for which m_Values are valid.
+			std::atomic<std::uint64_t> m_Epoch{ 0 };
+
+			/// Block is owned by running thread.
+			std::atomic<bool> m_InUse{ true };
+
+			/// Next block on list of all threads.
+			Counters* m_Next = nullptr;
+		};
+
+		/// Number of registered types.
+		inline std::atomic<std::size_t> g_TypeCount{ 0 };
+
+		/// Signatures of functions containing names of registered types.
+		inline std::atomic<char const*> g_TypeNames[MaxTypes] = {};
+
+		/// Lock-free list of counter blocks of all threads.
+		inline std::atomic<Counters*> g_Blocks{ nullptr };
+
+		/// Incremented by Reset. Blocks from previous epoch are treated as empty.
+		inline std::atomic<std::uint64_t> g_Epoch{ 0 };
+
+		/// Get signature of function, containing name of T.
+		template <typename T>
+		char const* Signature()
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			return __FUNCSIG__;
+#else
+			return __PRETTY_FUNCTION__;
+#endif
+		}
+
+		/// Extract type name from Signature.
+		/// @param signature. Value returned by Signature<T>().
+		inline std::string TypeName(std::string_view signature)
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			auto begin = signature.find("Signature<");
+			auto end = signature.rfind(">(void)");
+			if (begin == signature.npos || end == signature.npos)
+				return std::string{ signature };
+
+			begin += std::string_view{ "Signature<" }.size();
+#else
+			auto begin = signature.find("T = ");
+			auto end = signature.find_first_of(";]", begin);
+			if (begin == signature.npos || end == signature.npos)
+				return std::string{ signature };
+
+			begin += std::string_view{ "T = " }.size();
+#endif
+			return std::string{ signature.substr(begin, end - begin) };
+		}
+
+		/// Assign index to type.
+		/// @return index of type, or MaxTypes if limit was reached.
+		template <typename T>
+		std::size_t TypeIndex()
+		{
+			static auto const index = []
+			{
+				auto ret = g_TypeCount.fetch_add(1, std::memory_order_relaxed);
+				if (ret >= MaxTypes)
+					return MaxTypes;
+
+				g_TypeNames[ret].store(Signature<T>(), std::memory_order_release);
+				return ret;
+			}();
+
+			return index;
+		}
+
+		/// Take over block of finished thread, or register new one.
+		inline Counters* Acquire()
+		{
+			for (auto block = g_Blocks.load(std::memory_order_acquire); block; block = block->m_Next)
+			{
+				auto inUse = false;
+				if (block->m_InUse.compare_exchange_strong(inUse, true, std::memory_order_acquire, std::memory_order_relaxed))
+					return block;
+			}
+
+			auto block = new Counters{};
+			block->m_Epoch.store(g_Epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			block->m_Next = g_Blocks.load(std::memory_order_relaxed);
+			while (!g_Blocks.compare_exchange_weak(block->m_Next, block, std::memory_order_release, std::memory_order_relaxed));
+			return block;
+		}
+
+		/// Owner of block of one thread. Releases block for reuse when thread finishes. Counts stay in block.
+		struct Owner
+		{
+			Counters* m_Block;
+
+			~Owner()
+			{
+				m_Block->m_InUse.store(false, std::memory_order_release);
+			}
+		};
+
+		/// Get counters of calling thread. Block is acquired on first use.
+		inline Counters& Local()
+		{
+			thread_local auto const owner = Owner{ Acquire() };
+			return *owner.m_Block;
+		}
+
+		/// Add values to counters of calling thread.
+		/// @param index. Index of type.
+		/// @param direction. Direction of operation.
+		/// @param bytes. Number of bytes produced or consumed.
+		/// @param time. Duration of operation.
+		inline void Record(std::size_t index, Direction direction, std::uint64_t bytes, std::chrono::nanoseconds time)
+		{
+			if (index >= MaxTypes)
+				return;
+
+			auto& local = Local();
+			if (auto epoch = g_Epoch.load(std::memory_order_acquire); local.m_Epoch.load(std::memory_order_relaxed) != epoch)
+			{
+				for (auto& values : local.m_Values)
+					for (auto& value : values)
+						value.store(0, std::memory_order_relaxed);
+
+				local.m_Epoch.store(epoch, std::memory_order_release);
+			}
+
+			auto add = [&values = local.m_Values[index]](Counter counter, std::uint64_t value)
+			{
+				// Single writer, so there is no need for read-modify-write operation.
+				values[counter].store(values[counter].load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+			};
+
+			auto isWrite = direction == Direction::write;
+			add(isWrite ? Counter::writes : Counter::reads, 1);
+			add(isWrite ? Counter::bytesWritten : Counter::bytesRead, bytes);
+			add(isWrite ? Counter::writeTime : Counter::readTime, static_cast<std::uint64_t>(time.count()));
+		}
+
+		/// Measures one Store or Read call.
+		/// @tparam T. Type being processed.
+		/// @tparam D. Direction of operation.
+		template <typename T, Direction D>
+		class Probe
+		{
+		public:
+			/// Start measurement.
+			/// @param position. Size of ByteVector, or ByteView before operation.
+			explicit Probe(std::size_t position)
+				: m_Position{ position }
+				, m_Start{ std::chrono::steady_clock::now() }
+			{
+			}
+
+			/// Finish measurement.
+			/// @param position. Size of ByteVector, or ByteView after operation.
+			void Record(std::size_t position) const
+			{
+				auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_Start);
+				auto bytes = position > m_Position ? position - m_Position : m_Position - position;
+				Detail::Record(TypeIndex<T>(), D, bytes, time);
+			}
+
+		private:
+			/// Position before operation.
+			std::size_t m_Position;
+
+			/// Time before operation.
+			std::chrono::steady_clock::time_point m_Start;
+		};
+	}
+
+	/// Sum counters of all threads.
+	/// Values are read without synchronization with recording threads, so counters of different types may be shifted in time.
+	/// @return statistics of types that were written, or read since last Reset.
+	inline std::vector<TypeStatistics> Snapshot()
+	{
+		using namespace Detail;
+		std::uint64_t sums[MaxTypes][Counter::count] = {};
+		auto epoch = g_Epoch.load(std::memory_order_acquire);
+		for (auto block = g_Blocks.load(std::memory_order_acquire); block; block = block->m_Next)
+		{
+			if (block->m_Epoch.load(std::memory_order_acquire) != epoch)
+				continue;
+
+			for (auto type = std::size_t{ 0 }; type < MaxTypes; ++type)
+				for (auto counter = 0; counter < Counter::count; ++counter)
+					sums[type][counter] += block->m_Values[type][counter].load(std::memory_order_relaxed);
+		}
+
+		auto ret = std::vector<TypeStatistics>{};
+		auto typeCount = std::min(g_TypeCount.load(std::memory_order_acquire), MaxTypes);
+		for (auto type = std::size_t{ 0 }; type < typeCount; ++type)
+		{
+			auto const& sum = sums[type];
+			auto signature = g_TypeNames[type].load(std::memory_order_acquire);
+			if (!signature || !(sum[Counter::writes] || sum[Counter::reads]))
+				continue;
+
+			ret.push_back({ TypeName(signature), sum[Counter::writes], sum[Counter::bytesWritten], std::chrono::nanoseconds{ sum[Counter::writeTime] },
+				sum[Counter::reads], sum[Counter::bytesRead], std::chrono::nanoseconds{ sum[Counter::readTime] } });
+		}
+
+		return ret;
+	}
+
+	/// Reset counters of all threads.
+	/// Each thread clears its own counters on next recorded operation.
+	inline void Reset()
+	{
+		Detail::g_Epoch.fetch_add(1, std::memory_order_acq_rel);
+	}
+}
+
+/// Start measurement of operation on type T.
+#define BYTE_CONVERTER_METRICS_PROBE(direction, T, position) auto const byteConverterMetricsProbe = ::FSecure::Metrics::Detail::Probe<T, ::FSecure::Metrics::Direction::direction>{ position }
+
+/// Finish measurement started with BYTE_CONVERTER_METRICS_PROBE.
+#define BYTE_CONVERTER_METRICS_RECORD(position) byteConverterMetricsProbe.Record(position)
+
+#else
+
+#define BYTE_CONVERTER_METRICS_PROBE(direction, T, position) static_cast<void>(0)
+#define BYTE_CONVERTER_METRICS_RECORD(position) static_cast<void>(0)
+
+#endif
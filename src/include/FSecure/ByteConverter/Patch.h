@@ -0,0 +1,104 @@
+#pragma once
+
+#include "ByteSpan.h"
+
+namespace FSecure
+{
+	namespace Detail
+	{
+		/// Describes types serialized field after field, without separators.
+		/// Defined for tuples, and types whose ByteConverter inherits TupleConverter, e.g. PointerTupleConverter, or AggregateConverter.
+		template <typename T, typename = void>
+		struct SerializedFields
+		{
+			static constexpr bool value = false;
+		};
+
+		template <typename T>
+		struct SerializedFields<T, std::enable_if_t<Utils::IsTuple<T>::value>>
+		{
+			static constexpr bool value = true;
+
+			/// Tuple of serialized fields.
+			using Type = T;
+
+			/// Number of bytes preceding the first field.
+			static constexpr size_t HeaderSize = 0;
+		};
+
+		template <typename T>
+		struct SerializedFields<T, std::enable_if_t<!Utils::IsTuple<T>::value && std::is_base_of_v<TupleConverter<T>, ByteConverter<T>>>>
+		{
+			/// Helper class compatible with Utils::Apply. Counts nullable types.
+			struct CountNullable
+			{
+				template <typename ...Ts>
+				static constexpr auto Apply() -> size_t
+				{
+					return (size_t{ 0 } + ... + size_t{ Nullable<Utils::RemoveCVR<Ts>>::value });
+				}
+			};
+
+			static constexpr bool value = true;
+
+			/// Tuple returned by Convert.
+			using Type = decltype(ByteConverter<T>::Convert(std::declval<T const&>()));
+
+			/// Size of presence bitmap of nullable members.
+			static constexpr size_t HeaderSize = (Utils::Apply<CountNullable, Type>::value + 7) / 8;
+		};
+
+		/// Sum sizes of fields, that must be known at compilation time.
+		/// @tparam Fields. Tuple of serialized fields.
+		template <typename Fields, size_t ...Is>
+		constexpr size_t FieldsSize(std::index_sequence<Is...>)
+		{
+			static_assert((true && ... && (ConverterDeduction<Utils::RemoveCVR<std::tuple_element_t<Is, Fields>>>::FunctionSize::value == SizeFunction::compileTime)),
+				"All fields preceding patched one must have Size known at compilation time");
+
+			return (size_t{ 0 } + ... + ByteConverter<Utils::RemoveCVR<std::tuple_element_t<Is, Fields>>>::Size());
+		}
+	}
+
+	/// Type of field I of serialized T.
+	/// @tparam T. Tuple, or type whose ByteConverter inherits TupleConverter.
+	/// @tparam I. Index of field, in order of serialization.
+	template <typename T, size_t I>
+	using FieldType = Utils::RemoveCVR<std::tuple_element_t<I, typename Detail::SerializedFields<T>::Type>>;
+
+	/// Get position of field I in serialized T, computed at compilation time.
+	/// All preceding fields must have Size known at compilation time.
+	/// Offsets of nested objects are added, e.g. FieldOffset<Outer, 1>() + FieldOffset<Inner, 0>().
+	/// @tparam T. Tuple, or type whose ByteConverter inherits TupleConverter.
+	/// @tparam I. Index of field, in order of serialization.
+	/// @return number of bytes preceding field.
+	template <typename T, size_t I>
+	constexpr size_t FieldOffset()
+	{
+		using Fields = Detail::SerializedFields<T>;
+		static_assert(Fields::value, "Type is not serialized field after field");
+		static_assert(I < std::tuple_size_v<typename Fields::Type>, "Field index out of range");
+		return Fields::HeaderSize + Detail::FieldsSize<typename Fields::Type>(std::make_index_sequence<I>{});
+	}
+
+	/// Overwrite field of already serialized object, without decoding the rest of it.
+	/// Field must have Size known at compilation time, so new value takes exactly the space of old one.
+	/// @code Patch<Header, 2>(message, header.m_Hops + 1); @endcode
+	/// @tparam T. Tuple, or type whose ByteConverter inherits TupleConverter.
+	/// @tparam I. Index of field, in order of serialization.
+	/// @param buffer. ByteVector, or other writable contiguous memory, containing serialized T.
+	/// @param value. New value of field.
+	/// @param position. Position of serialized T in buffer.
+	/// @throws std::out_of_range if buffer is too small to contain field.
+	template <typename T, size_t I, typename Buffer, typename std::enable_if_t<Detail::IsWritableBuffer<Buffer>::value, int> = 0>
+	void Patch(Buffer& buffer, FieldType<T, I> const& value, size_t position = 0)
+	{
+		constexpr auto offset = FieldOffset<T, I>();
+		constexpr auto size = Detail::FieldsSize<std::tuple<FieldType<T, I>>>(std::index_sequence<0>{});
+		auto available = static_cast<size_t>(std::size(buffer));
+		if (position > available || available - position < offset + size)
+			BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Patched field is out of buffer") });
+
+		ByteSpan{ std::data(buffer) + position + offset, size }.Write(value);
+	}
+}
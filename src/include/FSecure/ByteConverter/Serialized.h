@@ -0,0 +1,135 @@
+#pragma once
+
+#include "ByteConverter.h"
+
+#include <mutex>
+
+namespace FSecure
+{
+	/// Immutable object together with cache of its serialized form.
+	/// Object is serialized once, on first use, and following writes copy cached bytes with single memcpy.
+	/// Copies share the same object and cache, so Serialized can be cheaply passed to many recipients.
+	/// Serialized data is identical to serialized T, so reader can use either T or Serialized<T>.
+	/// @code auto state = Serialized<State>{ GetState() }; for (auto& peer : peers) peer.Send(ByteVector::Create(header, state)); @endcode
+	/// @tparam T. Type of stored object.
+	template <typename T>
+	class Serialized
+	{
+	public:
+		/// Create from object.
+		/// @param obj. Object to be stored.
+		explicit Serialized(T obj)
+			: m_State{ std::make_shared<State>(std::move(obj)) }
+		{
+		}
+
+		/// Create from object and its already known serialized form.
+		/// @param obj. Object to be stored.
+		/// @param bytes. Result of serialization of obj.
+		Serialized(T obj, ByteVector bytes)
+			: Serialized{ std::move(obj) }
+		{
+			std::call_once(m_State->m_Once, [&] { m_State->m_Bytes = std::move(bytes); });
+		}
+
+		/// Get stored object.
+		T const& Get() const
+		{
+			return m_State->m_Object;
+		}
+
+		/// Access stored object.
+		T const& operator*() const
+		{
+			return Get();
+		}
+
+		/// Access stored object.
+		T const* operator->() const
+		{
+			return &Get();
+		}
+
+		/// Get serialized object. Serialization is done on first call.
+		/// Thread safe.
+		ByteView Bytes() const
+		{
+			std::call_once(m_State->m_Once, [this] { m_State->m_Bytes = ByteVector::Create(m_State->m_Object); });
+			return m_State->m_Bytes;
+		}
+
+	private:
+		/// State shared by all copies.
+		struct State
+		{
+			/// Create state.
+			/// @param obj. Object to be stored.
+			explicit State(T obj)
+				: m_Object{ std::move(obj) }
+			{
+			}
+
+			/// Stored object.
+			T const m_Object;
+
+			/// Guard of m_Bytes initialization.
+			std::once_flag m_Once;
+
+			/// Serialized m_Object.
+			ByteVector m_Bytes;
+		};
+
+		/// Shared state.
+		std::shared_ptr<State> m_State;
+	};
+
+	/// ByteConverter specialization for FSecure::Serialized.
+	template <typename T>
+	struct ByteConverter<Serialized<T>>
+	{
+		/// Copy cached bytes to ByteVector.
+		/// @param obj. Object to be serialized.
+		/// @param bv. ByteVector, or ByteSpan to be expanded.
+		template <typename Output>
+		static void To(Serialized<T> const& obj, Output& bv)
+		{
+			bv.Concat(obj.Bytes());
+		}
+
+		/// Get size required after serialization of type, whose size is known at compile time.
+		/// @note All template parameters are used only to determine if function should be defined.
+		/// @return size_t. Number of bytes used after serialization.
+		template <typename C = T>
+		static constexpr auto Size() -> std::enable_if_t<Detail::ConverterDeduction<C>::FunctionSize::value == Detail::SizeFunction::compileTime, size_t>
+		{
+			return ByteConverter<T>::Size();
+		}
+
+		/// Get size required after serialization. Serializes object if it was not done yet.
+		/// @note All template parameters are used only to determine if function should be defined.
+		/// @param obj. Object to be serialized.
+		/// @return size_t. Number of bytes used after serialization.
+		template <typename C = T>
+		static auto Size(Serialized<C> const& obj) -> std::enable_if_t<Detail::ConverterDeduction<C>::FunctionSize::value != Detail::SizeFunction::compileTime, size_t>
+		{
+			return obj.Bytes().size();
+		}
+
+		/// Deserialize from ByteView. Read bytes are cached, so object is not serialized again.
+		/// @param bv. Buffer with serialized data.
+		/// @return FSecure::Serialized.
+		static Serialized<T> From(ByteView& bv)
+		{
+			auto begin = bv;
+			auto obj = bv.Read<T>();
+			return { std::move(obj), begin.SubString(0, begin.size() - bv.size()) };
+		}
+
+		/// Skip serialized object without constructing it.
+		/// @param bv. Buffer with serialized data.
+		static void Skip(ByteView& bv)
+		{
+			bv.Skip<T>();
+		}
+	};
+}
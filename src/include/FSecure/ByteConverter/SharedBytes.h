@@ -0,0 +1,234 @@
+#pragma once
+
+#include "ByteConverter.h"
+
+namespace FSecure
+{
+	/// Immutable, reference counted buffer.
+	/// Slices share allocation of the buffer they were taken from, and keep it alive.
+	/// Copying, or slicing costs one reference count increment, so one payload can be handed to many consumers on different threads.
+	/// @code auto payload = SharedBytes{ std::move(received) }; Dispatch(payload.Slice(4)); @endcode
+	class SharedBytes
+	{
+	public:
+		/// Makes SharedBytes deserialized on current thread slices of buffer, instead of copies.
+		/// Only data located inside the buffer is shared, other data is copied.
+		/// @code auto scope = SharedBytes::Scope{ buffer }; auto [id, body] = ByteView{ buffer }.Read<uint32_t, SharedBytes>(); @endcode
+		class Scope
+		{
+		public:
+			/// Make buffer current until scope is destroyed.
+			/// @param buffer. Buffer that is read. Must outlive the scope.
+			explicit Scope(SharedBytes const& buffer)
+				: m_Previous{ Current() }
+			{
+				Current() = &buffer;
+			}
+
+			/// Restore previous buffer.
+			~Scope()
+			{
+				Current() = m_Previous;
+			}
+
+			Scope(Scope const&) = delete;
+			Scope& operator=(Scope const&) = delete;
+
+			/// Get buffer of innermost scope on current thread.
+			/// @return pointer to buffer, or nullptr if there is no scope.
+			static SharedBytes const* Get()
+			{
+				return Current();
+			}
+
+		private:
+			/// Buffer of innermost scope on current thread.
+			static SharedBytes const*& Current()
+			{
+				thread_local SharedBytes const* current = nullptr;
+				return current;
+			}
+
+			/// Buffer of enclosing scope.
+			SharedBytes const* m_Previous;
+		};
+
+		/// Create empty buffer.
+		SharedBytes() = default;
+
+		/// Take ownership of data without copying.
+		/// @param bytes. Data to be shared.
+		explicit SharedBytes(ByteVector bytes)
+		{
+			auto owner = std::make_shared<ByteVector const>(std::move(bytes));
+			m_View = *owner;
+			m_Owner = std::move(owner);
+		}
+
+		/// Copy data.
+		/// @param bytes. Data to be shared.
+		explicit SharedBytes(ByteView bytes)
+			: SharedBytes{ ByteVector{ bytes } }
+		{
+		}
+
+		/// Get part of buffer sharing the same allocation.
+		/// @param offset. Position of first byte.
+		/// @param count. Number of bytes. Slice ends at the end of buffer, if count is too large.
+		/// @return SharedBytes viewing part of buffer.
+		/// @throws std::out_of_range if offset is larger than size.
+		SharedBytes Slice(size_t offset, size_t count = ByteView::npos) const
+		{
+			if (offset > size())
+				BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Slice out of range of SharedBytes") });
+
+			return { m_Owner, m_View.SubString(offset, count) };
+		}
+
+		/// Get slice of buffer, if view points inside of it.
+		/// @param view. Part of buffer.
+		/// @return SharedBytes viewing the same memory as view, or empty std::optional if view is outside of buffer.
+		std::optional<SharedBytes> Slice(ByteView view) const
+		{
+			auto begin = std::less_equal<>{}(data(), view.data());
+			auto end = std::less_equal<>{}(view.data() + view.size(), data() + size());
+			if (!begin || !end || (view.empty() && view.data() == nullptr))
+				return {};
+
+			return SharedBytes{ m_Owner, view };
+		}
+
+		/// Get view of data.
+		operator ByteView() const
+		{
+			return m_View;
+		}
+
+		/// Get view of data.
+		ByteView View() const
+		{
+			return m_View;
+		}
+
+		/// Copy data to ByteVector.
+		ByteVector Copy() const
+		{
+			return m_View;
+		}
+
+		/// Get beginning of data.
+		std::uint8_t const* data() const
+		{
+			return m_View.data();
+		}
+
+		/// Get number of bytes.
+		size_t size() const
+		{
+			return m_View.size();
+		}
+
+		/// Check if buffer is empty.
+		bool empty() const
+		{
+			return m_View.empty();
+		}
+
+		/// Get iterator to the first byte.
+		auto begin() const
+		{
+			return m_View.begin();
+		}
+
+		/// Get iterator past the last byte.
+		auto end() const
+		{
+			return m_View.end();
+		}
+
+		/// Get number of SharedBytes objects sharing allocation.
+		long UseCount() const
+		{
+			return m_Owner.use_count();
+		}
+
+		/// Deserialize data, returning SharedBytes as slices of this buffer.
+		/// @tparam Ts. Types to be read.
+		/// @return object of type T, or tuple of objects if more types were provided.
+		template <typename T, typename ...Ts>
+		auto Read() const
+		{
+			auto scope = Scope{ *this };
+			return ByteView{ m_View }.Read<T, Ts...>();
+		}
+
+	private:
+		/// Create slice.
+		/// @param owner. Allocation of data.
+		/// @param view. Viewed part of allocation.
+		SharedBytes(std::shared_ptr<ByteVector const> owner, ByteView view)
+			: m_Owner{ std::move(owner) }
+			, m_View{ view }
+		{
+		}
+
+		/// Owner of memory.
+		std::shared_ptr<ByteVector const> m_Owner;
+
+		/// Viewed part of memory.
+		ByteView m_View;
+	};
+
+	/// Checks if the contents of lhs and rhs are equal.
+	/// @param lhs. Left hand side of operator.
+	/// @param rhs. Right hand side of operator.
+	inline bool operator==(SharedBytes const& lhs, SharedBytes const& rhs)
+	{
+		return lhs.View() == rhs.View();
+	}
+
+	/// Checks if the contents of lhs and rhs are not equal.
+	/// @param lhs. Left hand side of operator.
+	/// @param rhs. Right hand side of operator.
+	inline bool operator!=(SharedBytes const& lhs, SharedBytes const& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	/// ByteConverter specialization for FSecure::SharedBytes.
+	/// Serialized the same way as ByteView, so data can be read with any of ByteView, ByteVector, or SharedBytes.
+	template <>
+	struct ByteConverter<SharedBytes>
+	{
+		/// Serialize size and data to ByteVector.
+		/// @param obj. Object to be serialized.
+		/// @param bv. ByteVector, or ByteSpan to be expanded.
+		template <typename Output>
+		static void To(SharedBytes const& obj, Output& bv)
+		{
+			bv.Store(obj.View());
+		}
+
+		/// Get size required after serialization.
+		/// @param obj. Object to be serialized.
+		/// @return size_t. Number of bytes used after serialization.
+		static size_t Size(SharedBytes const& obj)
+		{
+			return ByteVector::Size(obj.View());
+		}
+
+		/// Deserialize from ByteView.
+		/// Data is shared with buffer of current SharedBytes::Scope if possible, otherwise it is copied.
+		/// @param bv. Buffer with serialized data.
+		/// @return FSecure::SharedBytes.
+		static SharedBytes From(ByteView& bv)
+		{
+			auto view = bv.Read<ByteView>();
+			if (auto scope = SharedBytes::Scope::Get())
+				if (auto slice = scope->Slice(view))
+					return std::move(*slice);
+
+			return SharedBytes{ view };
+		}
+	};
+}
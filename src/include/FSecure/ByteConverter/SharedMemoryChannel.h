@@ -0,0 +1,312 @@
+#pragma once
+
+#include "FrameRing.h"
+
+#if defined(__linux__)
+
+#include <chrono>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace FSecure
+{
+	/// Channel between processes on the same host, using FrameRing in POSIX shared memory.
+	/// Producer serializes directly into shared memory, consumer reads frames in place as ByteView, so data is never copied by kernel.
+	/// Blocking calls sleep on futex located in the segment.
+	/// @code auto channel = SharedMemoryChannel<>::Create("/collector", 1 << 20); channel.Write(header, body); @endcode
+	/// @tparam MultiProducer. Allow many producers, possibly in different processes.
+	template <bool MultiProducer = false>
+	class SharedMemoryChannel
+	{
+		/// State shared by processes, placed before ring.
+		struct Shared
+		{
+			/// Equal to Magic when segment is initialized.
+			alignas(64) std::atomic<uint32_t> m_Magic;
+
+			/// Space for frames.
+			uint32_t m_Capacity;
+
+			/// Incremented when frames are committed. Futex word of consumer.
+			alignas(64) std::atomic<uint32_t> m_Committed;
+
+			/// Number of processes sleeping on m_Committed.
+			std::atomic<uint32_t> m_CommittedWaiters;
+
+			/// Incremented when frames are released. Futex word of producers.
+			alignas(64) std::atomic<uint32_t> m_Released;
+
+			/// Number of processes sleeping on m_Released.
+			std::atomic<uint32_t> m_ReleasedWaiters;
+		};
+
+		/// Value marking initialized segment.
+		static constexpr uint32_t Magic = 0x42434843;
+
+		static_assert(std::atomic<uint32_t>::is_always_lock_free, "Futex requires lock-free atomics");
+
+	public:
+		/// Ring type placed in segment.
+		using Ring = FrameRing<MultiProducer>;
+
+		/// Space reserved for one frame.
+		using Reservation = typename Ring::Reservation;
+
+		/// Create and initialize segment. Segment is removed, when created channel is destroyed.
+		/// @param name. Name of segment, starting with slash, e.g. "/channel".
+		/// @param capacity. Space for frames. Must be power of two.
+		/// @return channel owning segment.
+		/// @throws std::system_error if segment cannot be created, e.g. because it already exists.
+		static SharedMemoryChannel Create(std::string name, size_t capacity)
+		{
+			if (capacity > (std::numeric_limits<uint32_t>::max)())
+				BYTE_CONVERTER_THROW(std::invalid_argument{ OBF(": SharedMemoryChannel capacity is too large") });
+
+			auto descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+			if (descriptor == -1)
+				BYTE_CONVERTER_THROW(std::system_error{ errno, std::system_category(), OBF("shm_open") });
+
+			auto ret = SharedMemoryChannel{ std::move(name) };
+			auto size = sizeof(Shared) + Ring::RequiredMemory(capacity);
+			if (ftruncate(descriptor, static_cast<off_t>(size)) == -1)
+			{
+				auto error = errno;
+				close(descriptor);
+				BYTE_CONVERTER_THROW(std::system_error{ error, std::system_category(), OBF("ftruncate") });
+			}
+
+			ret.Map(descriptor, size);
+			ret.m_Shared = new (ret.m_Memory) Shared{};
+			ret.m_Shared->m_Capacity = static_cast<uint32_t>(capacity);
+			ret.m_Ring = std::make_unique<Ring>(ret.m_Memory + sizeof(Shared), capacity, true);
+			ret.m_Shared->m_Magic.store(Magic, std::memory_order_release);
+			return ret;
+		}
+
+		/// Open segment created by other process.
+		/// @param name. Name of segment, passed to Create.
+		/// @return channel using segment.
+		/// @throws std::system_error if segment does not exist, or was not initialized.
+		static SharedMemoryChannel Open(std::string const& name)
+		{
+			auto descriptor = shm_open(name.c_str(), O_RDWR, 0);
+			if (descriptor == -1)
+				BYTE_CONVERTER_THROW(std::system_error{ errno, std::system_category(), OBF("shm_open") });
+
+			struct stat status;
+			if (fstat(descriptor, &status) == -1 || static_cast<size_t>(status.st_size) < sizeof(Shared))
+			{
+				close(descriptor);
+				BYTE_CONVERTER_THROW(std::system_error{ std::make_error_code(std::errc::invalid_argument), OBF("fstat") });
+			}
+
+			auto ret = SharedMemoryChannel{ std::string{} };
+			ret.Map(descriptor, static_cast<size_t>(status.st_size));
+			ret.m_Shared = std::launder(reinterpret_cast<Shared*>(ret.m_Memory));
+			if (ret.m_Shared->m_Magic.load(std::memory_order_acquire) != Magic || sizeof(Shared) + Ring::RequiredMemory(ret.m_Shared->m_Capacity) > ret.m_Size)
+				BYTE_CONVERTER_THROW(std::system_error{ std::make_error_code(std::errc::invalid_argument), OBF("SharedMemoryChannel is not initialized") });
+
+			ret.m_Ring = std::make_unique<Ring>(ret.m_Memory + sizeof(Shared), ret.m_Shared->m_Capacity, false);
+			return ret;
+		}
+
+		/// Move constructor.
+		/// @param other. Object to move.
+		SharedMemoryChannel(SharedMemoryChannel&& other)
+			: m_Name{ std::exchange(other.m_Name, {}) }
+			, m_Memory{ std::exchange(other.m_Memory, nullptr) }
+			, m_Size{ std::exchange(other.m_Size, 0) }
+			, m_Shared{ std::exchange(other.m_Shared, nullptr) }
+			, m_Ring{ std::move(other.m_Ring) }
+		{
+		}
+
+		SharedMemoryChannel(SharedMemoryChannel const&) = delete;
+		SharedMemoryChannel& operator=(SharedMemoryChannel const&) = delete;
+		SharedMemoryChannel& operator=(SharedMemoryChannel&&) = delete;
+
+		/// Unmap segment. Segment is removed, if it was created by this channel.
+		~SharedMemoryChannel()
+		{
+			m_Ring.reset();
+			if (m_Memory)
+				munmap(m_Memory, m_Size);
+
+			if (!m_Name.empty())
+				shm_unlink(m_Name.c_str());
+		}
+
+		/// Get ring in shared memory, e.g. to reserve many frames before committing them together.
+		Ring& Frames()
+		{
+			return *m_Ring;
+		}
+
+		/// Reserve space for frame.
+		/// @see FrameRing::Reserve.
+		std::optional<Reservation> Reserve(size_t size)
+		{
+			return m_Ring->Reserve(size);
+		}
+
+		/// Publish frame and wake consumer.
+		/// @param reservation. Frame to be published.
+		void Commit(Reservation const& reservation)
+		{
+			m_Ring->Commit(reservation);
+			Notify(m_Shared->m_Committed, m_Shared->m_CommittedWaiters);
+		}
+
+		/// Publish frames together and wake consumer once.
+		/// @param first. Iterator to the first reservation.
+		/// @param last. Iterator past the last reservation.
+		template <typename Iterator>
+		void Commit(Iterator first, Iterator last)
+		{
+			m_Ring->Commit(first, last);
+			Notify(m_Shared->m_Committed, m_Shared->m_CommittedWaiters);
+		}
+
+		/// Serialize objects into one frame, without waiting.
+		/// @param args. Objects to be stored.
+		/// @return false if there is not enough free space.
+		template <typename ...Ts>
+		bool TryWrite(Ts const& ...args)
+		{
+			if (!m_Ring->TryWrite(args...))
+				return false;
+
+			Notify(m_Shared->m_Committed, m_Shared->m_CommittedWaiters);
+			return true;
+		}
+
+		/// Serialize objects into one frame, waiting until consumer releases enough space.
+		/// @param args. Objects to be stored.
+		template <typename ...Ts>
+		void Write(Ts const& ...args)
+		{
+			while (true)
+			{
+				// Word is read before attempt, so release made after failed attempt is never missed.
+				auto released = m_Shared->m_Released.load();
+				if (TryWrite(args...))
+					return;
+
+				Sleep(m_Shared->m_Released, m_Shared->m_ReleasedWaiters, released, nullptr);
+			}
+		}
+
+		/// Get next committed frame.
+		/// @see FrameRing::Next.
+		std::optional<ByteView> Next()
+		{
+			return m_Ring->Next();
+		}
+
+		/// Release all frames returned by Next, and wake producers waiting for space.
+		void Release()
+		{
+			m_Ring->Release();
+			Notify(m_Shared->m_Released, m_Shared->m_ReleasedWaiters);
+		}
+
+		/// Process available frames, release them together, and wake producers waiting for space.
+		/// @see FrameRing::Consume.
+		template <typename Consumer>
+		size_t Consume(Consumer&& consumer, size_t maxFrames = static_cast<size_t>(-1))
+		{
+			auto ret = m_Ring->Consume(std::forward<Consumer>(consumer), maxFrames);
+			if (ret)
+				Notify(m_Shared->m_Released, m_Shared->m_ReleasedWaiters);
+
+			return ret;
+		}
+
+		/// Wait until frame is committed. May return early, e.g. because of signal.
+		/// @param timeout. Maximal time of waiting.
+		/// @return true if frame may be available.
+		template <typename Rep, typename Period>
+		bool WaitForData(std::chrono::duration<Rep, Period> timeout)
+		{
+			auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+			auto time = timespec{ static_cast<time_t>(seconds.count()), static_cast<long>(std::chrono::duration_cast<std::chrono::nanoseconds>(timeout - seconds).count()) };
+			auto committed = m_Shared->m_Committed.load();
+			if (m_Ring->HasFrame())
+				return true;
+
+			Sleep(m_Shared->m_Committed, m_Shared->m_CommittedWaiters, committed, &time);
+			return m_Ring->HasFrame();
+		}
+
+	private:
+		/// Create channel without segment.
+		/// @param name. Name of segment removed in destructor.
+		explicit SharedMemoryChannel(std::string name)
+			: m_Name{ std::move(name) }
+		{
+		}
+
+		/// Map segment to memory. Descriptor is closed.
+		/// @param descriptor. Descriptor of segment.
+		/// @param size. Size of segment.
+		void Map(int descriptor, size_t size)
+		{
+			auto memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+			auto error = errno;
+			close(descriptor);
+			if (memory == MAP_FAILED)
+				BYTE_CONVERTER_THROW(std::system_error{ error, std::system_category(), OBF("mmap") });
+
+			m_Memory = static_cast<uint8_t*>(memory);
+			m_Size = size;
+		}
+
+		/// Sleep on futex word, unless it was changed.
+		/// Notifier increments word before it checks waiters, so either futex sees changed word, or notifier sees waiter.
+		/// @param word. Futex word.
+		/// @param waiters. Number of sleeping processes.
+		/// @param value. Value of word read before condition of waiting was checked.
+		/// @param timeout. Maximal time of sleeping, or nullptr.
+		static void Sleep(std::atomic<uint32_t>& word, std::atomic<uint32_t>& waiters, uint32_t value, timespec const* timeout)
+		{
+			waiters.fetch_add(1);
+			syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, value, timeout, nullptr, 0);
+			waiters.fetch_sub(1);
+		}
+
+		/// Wake all processes sleeping on futex word.
+		/// @param word. Futex word.
+		/// @param waiters. Number of sleeping processes.
+		static void Notify(std::atomic<uint32_t>& word, std::atomic<uint32_t>& waiters)
+		{
+			word.fetch_add(1);
+			if (waiters.load())
+				syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+		}
+
+		/// Name of segment created by this channel.
+		std::string m_Name;
+
+		/// Mapped segment.
+		uint8_t* m_Memory = nullptr;
+
+		/// Size of mapped segment.
+		size_t m_Size = 0;
+
+		/// State shared by processes.
+		Shared* m_Shared = nullptr;
+
+		/// Ring placed in segment.
+		std::unique_ptr<Ring> m_Ring;
+	};
+}
+
+#endif
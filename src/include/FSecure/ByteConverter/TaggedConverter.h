@@ -0,0 +1,284 @@
+#pragma once
+
+#include "ByteConverter.h"
+
+namespace FSecure
+{
+	namespace Detail
+	{
+		/// Get number of bytes of unsigned LEB128 encoding.
+		/// @param value. Encoded number.
+		constexpr size_t VarintSize(uint32_t value)
+		{
+			auto ret = size_t{ 1 };
+			while (value >>= 7)
+				++ret;
+
+			return ret;
+		}
+
+		/// Read number stored as unsigned LEB128.
+		/// @param bv. Buffer with serialized data.
+		/// @throws std::out_of_range if encoding is longer than five bytes.
+		inline uint32_t ReadVarint(ByteView& bv)
+		{
+			auto ret = uint32_t{ 0 };
+			for (auto shift = 0; shift < 35; shift += 7)
+			{
+				auto byte = bv.Read<uint8_t>();
+				ret |= static_cast<uint32_t>(byte & 0x7f) << shift;
+				if (!(byte & 0x80))
+					return ret;
+			}
+
+			BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Varint is too long") });
+		}
+	}
+
+	/// Member serialized by TaggedConverter, identified by tag instead of position.
+	/// @tparam M. Pointer to member type.
+	template <typename M>
+	struct TaggedMember
+	{
+		/// Create tagged member.
+		/// @param tag. Identifier of member. Must be unique within type, and never reused for different data.
+		/// @param pointer. Pointer to member.
+		constexpr TaggedMember(uint32_t tag, M pointer)
+			: m_Tag{ tag }
+			, m_Pointer{ pointer }
+		{
+		}
+
+		/// Identifier of member.
+		uint32_t m_Tag;
+
+		/// Pointer to member.
+		M m_Pointer;
+	};
+
+	/// @brief Class providing ByteConverter whose wire format survives adding and removing members.
+	/// ByteConverter can use this functionality by inheriting from TaggedConverter and providing
+	/// public static std::tuple<TaggedMember<T::*>...> TaggedMembers() method.
+	/// Object is serialized as uint32_t length, followed by fields. Each field is varint tag, uint32_t length, and serialized member.
+	/// Reader skips fields with unknown tags without decoding them, and leaves members without field default initialized.
+	/// Empty std::optional, std::unique_ptr and std::shared_ptr members are omitted.
+	/// @tparam T Type for serialization. Must have default constructor.
+	template <typename T>
+	struct TaggedConverter
+	{
+		/// @brief Serialize tagged members.
+		/// Lengths are written after data, so members are serialized in single pass.
+		/// @param obj Object for serialization.
+		/// @param bv output ByteVector, or ByteSpan.
+		template <typename Output>
+		static void To(T const& obj, Output& bv)
+		{
+			auto position = bv.size();
+			bv.Store(uint32_t{ 0 });
+			std::apply([&](auto const& ...members) { (StoreField(obj.*members.m_Pointer, members.m_Tag, bv), ...); }, ByteConverter<T>::TaggedMembers());
+			Patch(bv, position);
+		}
+
+		/// @brief Get size required after serialization.
+		/// @param obj Object for serialization.
+		/// @return size_t. Number of bytes used after serialization.
+		static size_t Size(T const& obj)
+		{
+			return std::apply([&](auto const& ...members) { return (sizeof(uint32_t) + ... + FieldSize(obj.*members.m_Pointer, members.m_Tag)); }, ByteConverter<T>::TaggedMembers());
+		}
+
+		/// @brief Deserialize object. Members without field keep values of default constructed object.
+		/// @param bv. Buffer with serialized data.
+		/// @return constructed type.
+		static T From(ByteView& bv)
+		{
+			auto ret = T{};
+			ReadFields(bv, ret, false, [](auto const&) { return true; });
+			return ret;
+		}
+
+		/// @brief Deserialize into existing object, reusing resources of its members.
+		/// Members without field are reset to values of default constructed object.
+		/// @param bv. Buffer with serialized data.
+		/// @param obj. Object to be overwritten.
+		static void From(ByteView& bv, T& obj)
+		{
+			ReadFields(bv, obj, true, [](auto const&) { return true; });
+		}
+
+		/// @brief Skip serialized object in constant time.
+		/// @param bv. Buffer with serialized data.
+		static void Skip(ByteView& bv)
+		{
+			Take(bv);
+		}
+
+		/// @brief Read only selected members into existing object. Fields of other members are skipped without being decoded.
+		/// @tparam Ms. Pointers to selected members. Members that are not selected, or have no field, are left untouched.
+		/// @param bv. Buffer with serialized data.
+		/// @param obj. Object to be partially overwritten.
+		/// @see FSecure::Project.
+		template <auto ...Ms>
+		static void ReadProjection(ByteView& bv, T& obj)
+		{
+			ReadFields(bv, obj, false, [&obj](auto const& member) { return ((static_cast<void const*>(&member) == static_cast<void const*>(&(obj.*Ms))) || ...); });
+		}
+
+	private:
+		/// @brief Store number as unsigned LEB128.
+		/// @param value. Number to be stored.
+		/// @param bv. ByteVector, or ByteSpan to be expanded.
+		template <typename Output>
+		static void StoreVarint(uint32_t value, Output& bv)
+		{
+			while (value >= 0x80)
+			{
+				bv.Store(static_cast<uint8_t>(value | 0x80));
+				value >>= 7;
+			}
+
+			bv.Store(static_cast<uint8_t>(value));
+		}
+
+		/// @brief Store member as field. Empty nullable members are omitted.
+		/// @param member. Member to be stored.
+		/// @param tag. Identifier of member.
+		/// @param bv output ByteVector, or ByteSpan.
+		template <typename M, typename Output>
+		static void StoreField(M const& member, uint32_t tag, Output& bv)
+		{
+			if constexpr (Detail::Nullable<M>::value)
+			{
+				if (!member)
+					return;
+			}
+
+			StoreVarint(tag, bv);
+			auto position = bv.size();
+			bv.Store(uint32_t{ 0 });
+			if constexpr (Detail::Nullable<M>::value)
+				bv.Store(*member);
+			else
+				bv.Store(member);
+
+			Patch(bv, position);
+		}
+
+		/// @brief Get size of field.
+		/// @param member. Member to be measured.
+		/// @param tag. Identifier of member.
+		template <typename M>
+		static size_t FieldSize(M const& member, uint32_t tag)
+		{
+			if constexpr (Detail::Nullable<M>::value)
+				return member ? Detail::VarintSize(tag) + sizeof(uint32_t) + ByteVector::Size(*member) : 0;
+			else
+				return Detail::VarintSize(tag) + sizeof(uint32_t) + ByteVector::Size(member);
+		}
+
+		/// @brief Write length of data following placeholder.
+		/// @param bv. ByteVector, or ByteSpan with placeholder.
+		/// @param position. Position of placeholder.
+		/// @throws std::out_of_range if data is larger than uint32_t can express.
+		template <typename Output>
+		static void Patch(Output& bv, size_t position)
+		{
+			auto length = bv.size() - position - sizeof(uint32_t);
+			if (length > (std::numeric_limits<uint32_t>::max)())
+				BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Tagged field exceeds maximal size") });
+
+			auto value = static_cast<uint32_t>(length);
+			memcpy(bv.data() + position, &value, sizeof(value));
+		}
+
+		/// @brief Read fields into members.
+		/// @param bv. Buffer with serialized data.
+		/// @param obj. Object to be overwritten.
+		/// @param reset. Reset members without field.
+		/// @param selected. Predicate taking member of obj. Fields of other members are skipped.
+		template <typename Selected>
+		static void ReadFields(ByteView& bv, T& obj, bool reset, Selected const& selected)
+		{
+			auto members = ByteConverter<T>::TaggedMembers();
+			constexpr auto count = std::tuple_size_v<decltype(members)>;
+			auto read = std::array<bool, count>{};
+			auto message = Take(bv);
+			while (!message.empty())
+			{
+				auto tag = Detail::ReadVarint(message);
+				auto field = Take(message);
+				ReadField(field, obj, members, tag, read, selected, std::make_index_sequence<count>{});
+			}
+
+			if (reset)
+				ResetMissing(obj, members, read, std::make_index_sequence<count>{});
+		}
+
+		/// @brief Read data prefixed with uint32_t length.
+		/// @param bv. Buffer with serialized data.
+		/// @return view of data.
+		/// @throws std::out_of_range if buffer is shorter than length.
+		static ByteView Take(ByteView& bv)
+		{
+			auto length = bv.Read<uint32_t>();
+			if (length > bv.size())
+				BYTE_CONVERTER_THROW(std::out_of_range{ OBF(": Cannot read data from ByteView") });
+
+			auto ret = bv.SubString(0, length);
+			bv.remove_prefix(length);
+			return ret;
+		}
+
+		/// @brief Read field into member with matching tag. Field with unknown tag is skipped.
+		/// Trailing data of field is ignored, so member can be extended by newer writers.
+		template <typename Members, typename Read, typename Selected, size_t ...Is>
+		static void ReadField(ByteView field, T& obj, Members const& members, uint32_t tag, Read& read, Selected const& selected, std::index_sequence<Is...>)
+		{
+			auto readMember = [&](auto const& member, bool& wasRead)
+			{
+				if (member.m_Tag != tag)
+					return false;
+
+				auto& value = obj.*member.m_Pointer;
+				if (!selected(value))
+					return true;
+
+				if constexpr (Detail::Nullable<Utils::RemoveCVR<decltype(value)>>::value)
+					Detail::ReadNullableInto(field, value, true);
+				else
+					field.ReadInto(value);
+
+				wasRead = true;
+				return true;
+			};
+
+			(readMember(std::get<Is>(members), read[Is]) || ...);
+		}
+
+		/// @brief Reset members without field to values of default constructed object.
+		template <typename Members, typename Read, size_t ...Is>
+		static void ResetMissing(T& obj, Members const& members, Read const& read, std::index_sequence<Is...>)
+		{
+			auto resetMember = [&](auto const& member, bool wasRead)
+			{
+				if (wasRead)
+					return;
+
+				auto& value = obj.*member.m_Pointer;
+				if constexpr (Detail::Nullable<Utils::RemoveCVR<decltype(value)>>::value)
+					value.reset();
+				else
+					value = Defaults().*member.m_Pointer;
+			};
+
+			(resetMember(std::get<Is>(members), read[Is]), ...);
+		}
+
+		/// @brief Default constructed object, source of values of missing members.
+		static T const& Defaults()
+		{
+			static auto const defaults = T{};
+			return defaults;
+		}
+	};
+}
@@ -4,6 +4,8 @@
 #include <type_traits>
 #include <utility>
 #include <functional>
+#include <memory_resource>
+#include <new>
 #include <array>
 #include <vector>
 #include <tuple>
@@ -87,6 +89,16 @@ namespace FSecure::Utils
 
 		template <typename T>
 		struct IsView<std::basic_string_view<T>, void> : std::true_type {};
+
+		template <typename T>
+		struct MemberOf {};
+
+		template <typename C, typename M>
+		struct MemberOf<M C::*>
+		{
+			using Class = C;
+			using Member = M;
+		};
 	}
 
 	/// Idiom for detecting tuple.
@@ -101,6 +113,10 @@ namespace FSecure::Utils
 	template <typename T>
 	struct IsView : Impl::IsView<T> {};
 
+	/// Decompose pointer to member into class and type of member.
+	template <typename T>
+	struct MemberOf : Impl::MemberOf<T> {};
+
 	/// Namespace full of helpers for containers template programing.
 	namespace Container
 	{
@@ -134,6 +150,36 @@ namespace FSecure::Utils
 
 			template <typename T>
 			struct HasReserve<T, std::void_t<decltype(std::declval<T>().reserve(size_t{}))>> : std::true_type {};
+
+			template <typename T, typename = void>
+			struct HasResize : std::false_type {};
+
+			template <typename T>
+			struct HasResize<T, std::void_t<decltype(std::declval<T&>().resize(size_t{}))>> : std::true_type {};
+
+			template <typename T, typename = void>
+			struct HasExtract : std::false_type {};
+
+			template <typename T>
+			struct HasExtract<T, std::void_t<typename T::node_type, decltype(std::declval<T&>().extract(std::declval<T&>().begin()))>> : std::true_type {};
+
+			template <typename T, typename = void>
+			struct UsesPolymorphicAllocator : std::false_type {};
+
+			template <typename T>
+			struct UsesPolymorphicAllocator<T, std::enable_if_t<std::is_same_v<typename T::allocator_type, std::pmr::polymorphic_allocator<typename T::allocator_type::value_type>>>> : std::true_type {};
+
+			template <typename T, typename = void>
+			struct IsArray : std::false_type {};
+
+			template <typename T, size_t N>
+			struct IsArray<std::array<T, N>> : std::true_type {};
+
+			template <typename T, typename = void>
+			struct IsContiguous : std::false_type {};
+
+			template <typename T>
+			struct IsContiguous<T, std::enable_if_t<std::is_same_v<decltype(std::declval<T&>().data()), StoredValue<T>*>>> : std::true_type {};
 		}
 
 		/// Check if type can be iterated with begin() and end().
@@ -152,11 +198,31 @@ namespace FSecure::Utils
 		template <typename T>
 		struct HasReserve : Impl::HasReserve<T> {};
 
+		/// Check if type can change number of elements with resize(size_t).
+		template <typename T>
+		struct HasResize : Impl::HasResize<T> {};
+
+		/// Check if type allows extraction of nodes, that can be reused.
+		template <typename T>
+		struct HasExtract : Impl::HasExtract<T> {};
+
+		/// Check if type allocates memory with std::pmr::polymorphic_allocator.
+		template <typename T>
+		struct UsesPolymorphicAllocator : Impl::UsesPolymorphicAllocator<T> {};
+
+		/// Check if type is std::array.
+		template <typename T>
+		struct IsArray : Impl::IsArray<T> {};
+
+		/// Check if type stores elements in contiguous, writable memory accessible with data().
+		template <typename T>
+		struct IsContiguous : Impl::IsContiguous<T> {};
+
 		/// Returns number of elements in container, if size(T const&), or pair of begin(T const&), end(T const&) functions can be found.
 		struct Size
 		{
 			template <typename T>
-			auto operator () (T const& obj) const -> std::enable_if_t<HasDedicatedSize<T>::value || IsIterable<T>::value, size_t>
+			constexpr auto operator () (T const& obj) const -> std::enable_if_t<HasDedicatedSize<T>::value || IsIterable<T>::value, size_t>
 			{
 				size_t count = 0;
 				if constexpr (HasDedicatedSize<T>::value) count = size(obj);
@@ -166,6 +232,81 @@ namespace FSecure::Utils
 			}
 		};
 
+		/// Selects memory resource used for containers created during deserialization on current thread.
+		/// Containers using std::pmr::polymorphic_allocator are constructed with resource of innermost living scope.
+		/// Without any scope std::pmr::get_default_resource() is used.
+		class MemoryResourceScope
+		{
+		public:
+			/// Make resource current until scope is destroyed.
+			/// @param resource. Memory resource for new containers. Must outlive the scope.
+			explicit MemoryResourceScope(std::pmr::memory_resource& resource)
+				: m_Previous{ Current() }
+			{
+				Current() = &resource;
+			}
+
+			/// Restore previous resource.
+			~MemoryResourceScope()
+			{
+				Current() = m_Previous;
+			}
+
+			MemoryResourceScope(MemoryResourceScope const&) = delete;
+			MemoryResourceScope& operator=(MemoryResourceScope const&) = delete;
+
+			/// Get resource for new containers.
+			static std::pmr::memory_resource* Get()
+			{
+				return Current() ? Current() : std::pmr::get_default_resource();
+			}
+
+		private:
+			/// Resource of innermost scope on current thread.
+			static std::pmr::memory_resource*& Current()
+			{
+				thread_local std::pmr::memory_resource* current = nullptr;
+				return current;
+			}
+
+			/// Resource of enclosing scope.
+			std::pmr::memory_resource* m_Previous;
+		};
+
+		/// Create empty container.
+		/// Containers using std::pmr::polymorphic_allocator are bound to MemoryResourceScope::Get().
+		/// @tparam T. Type to be constructed.
+		template <typename T>
+		T Construct()
+		{
+			if constexpr (UsesPolymorphicAllocator<T>::value)
+				return T(typename T::allocator_type{ MemoryResourceScope::Get() });
+			else
+				return T{};
+		}
+
+		/// Bind empty member of newly constructed object to MemoryResourceScope::Get().
+		/// Move assignment does not propagate std::pmr::polymorphic_allocator, so container is recreated in place.
+		/// Elements of arrays and tuples, that are read in place, are bound as well. Other types are left untouched.
+		/// @param obj. Empty container, or other object.
+		template <typename T>
+		void Rebind(T& obj)
+		{
+			if constexpr (UsesPolymorphicAllocator<T>::value)
+			{
+				if (obj.get_allocator().resource() == MemoryResourceScope::Get())
+					return;
+
+				auto bound = Construct<T>();
+				obj.~T();
+				new (&obj) T(std::move(bound));
+			}
+			else if constexpr (IsArray<T>::value || IsTuple<T>::value)
+			{
+				std::apply([](auto& ...elements) { (Rebind(elements), ...); }, obj);
+			}
+		}
+
 		/// Struct to generalize container construction.
 		/// Defines one of allowed operators that will return requested container.
 		/// @tparam T. Type to be constructed.
@@ -194,7 +335,7 @@ namespace FSecure::Utils
 			/// @param next. Functor returning one of container values at a time.
 			T operator()(uint32_t size, std::function<StoredValue<T>()> next)
 			{
-				T ret;
+				auto ret = Construct<T>();
 				if constexpr (HasReserve<T>::value)
 					ret.reserve(size);
 
@@ -233,24 +374,19 @@ namespace FSecure::Utils
 				if (size != N)
 					BYTE_CONVERTER_THROW(std::runtime_error{ OBF("Array size does not match declaration") });
 
-				std::vector<T> temp;
-				temp.reserve(N);
-				for (auto i = 0u; i < N; ++i)
-					temp.push_back(next());
-
-				return MakeArray(std::move(temp), std::make_index_sequence<N>());
+				return MakeArray(next, std::make_index_sequence<N>());
 			}
 
 		private:
-			/// Create array with size N from provided vector.
+			/// Create array with size N, constructing elements in place.
 			/// This helper function is required because T might not be default constructible, but array must be filled like aggregator.
-			/// Reading data to vector first will ensure order of elements, independent of calling convention.
-			/// @param obj. Temporary vector with data.
+			/// Elements of braced initializer list are evaluated in order, so elements are read in order without temporary storage.
+			/// @param next. Functor returning one of container values at a time.
 			/// @returns std::array with all elements.
 			template<size_t... Is>
-			std::array<T, N> MakeArray(std::vector<T>&& obj, std::index_sequence<Is...>)
+			std::array<T, N> MakeArray(std::function<T()> const& next, std::index_sequence<Is...>)
 			{
-				return { std::move(obj[Is])... };
+				return { (static_cast<void>(Is), next())... };
 			}
 		};
 
@@ -361,7 +497,7 @@ namespace FSecure::Utils
 	/// @param ...args arguments to be stored in tuple
 	/// @return tuple with references to non trivial types, and values of simple ones.
 	template<typename ...Args>
-	auto MakeConversionTuple(Args&& ...args)
+	constexpr auto MakeConversionTuple(Args&& ...args)
 	{
 		return std::tuple<AddConstRefToNonTrivialT<Args&&>...>(std::forward<Args>(args)...);
 	}
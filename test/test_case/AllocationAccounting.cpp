@@ -0,0 +1,129 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/ByteConverter.h"
+
+using namespace FSecure;
+
+namespace AllocationAccounting
+{
+	using Operation = AllocationStatistics::Operation;
+
+	/// Enables accounting for lifetime of object.
+	struct Fixture
+	{
+		Fixture()
+		{
+			AllocationStatistics::Reset();
+			AllocationStatistics::Enable();
+		}
+
+		~Fixture()
+		{
+			AllocationStatistics::Enable(false);
+			AllocationStatistics::Reset();
+		}
+	};
+
+	/// Find counters of operation called from line of this file.
+	AllocationStatistics::SiteCounters const* FindSite(std::vector<AllocationStatistics::SiteCounters> const& sites, Operation operation, unsigned line)
+	{
+		for (auto const& site : sites)
+			if (site.m_Operation == operation && site.m_Site.m_File && std::string_view{ site.m_Site.m_File }.find("AllocationAccounting") != std::string_view::npos && site.m_Site.m_Line == line)
+				return &site;
+
+		return nullptr;
+	}
+
+	TEST_CASE_METHOD(Fixture, "Allocation accounting.")
+	{
+		SECTION("Disabled accounting does not record.")
+		{
+			AllocationStatistics::Enable(false);
+			ByteVector::Create(1, 2, 3);
+			CHECK_FALSE(AllocationStatistics::IsEnabled());
+			CHECK(AllocationStatistics::Get(Operation::create).m_Calls == 0);
+		}
+
+		SECTION("Create allocates once and attributes nested calls to itself.")
+		{
+			auto bv = ByteVector::Create(std::vector<std::string>{ "a", "bb", "ccc" }, 7);
+			auto create = AllocationStatistics::Get(Operation::create);
+			CHECK(create.m_Calls == 1);
+			CHECK(create.m_Allocations == 1);
+			CHECK(create.m_Reallocations == 0);
+			CHECK(create.m_CapacitySlack == bv.capacity() - bv.size());
+			CHECK(AllocationStatistics::Get(Operation::write).m_Calls == 0);
+		}
+
+		SECTION("Reallocations of chained writes are counted.")
+		{
+			auto bv = ByteVector{};
+			auto allocations = 0u, reallocations = 0u;
+			auto bytesCopied = size_t{ 0 };
+			for (auto i = 0; i < 100; ++i)
+			{
+				auto capacity = bv.capacity();
+				auto size = bv.size();
+				bv.Write(i);
+				if (bv.capacity() != capacity)
+					(capacity ? (bytesCopied += size, ++reallocations) : ++allocations);
+			}
+
+			auto write = AllocationStatistics::Get(Operation::write);
+			CHECK(write.m_Calls == 100);
+			CHECK(write.m_Allocations == allocations);
+			CHECK(write.m_Reallocations == reallocations);
+			CHECK(write.m_BytesCopied == bytesCopied);
+		}
+
+		SECTION("Calls are accounted per call site.")
+		{
+			using CallSite = AllocationStatistics::CallSite;
+			auto bv = ByteVector{};
+			auto writeSite = CallSite{};
+			for (auto i = 0; i < 10; ++i)
+			{
+				writeSite = CallSite::Current();
+				bv.Write(writeSite, std::string(100, 'x'), i, uint8_t{ 1 });
+			}
+
+			auto createSite = CallSite::Current();
+			auto created = ByteVector::Create(createSite, std::vector<int>{ 1, 2, 3 }, 4);
+			auto concatSite = CallSite::Current();
+			bv.Concat(concatSite, std::move(created));
+			ByteVector::Create(1, 2);
+
+			auto sites = AllocationStatistics::Sites();
+			auto write = FindSite(sites, Operation::write, writeSite.m_Line);
+			REQUIRE(write);
+			CHECK(write->m_Counters.m_Calls == 10);
+			CHECK(write->m_Counters.m_Allocations == 1);
+			CHECK(write->m_Counters.m_Reallocations == AllocationStatistics::Get(Operation::write).m_Reallocations);
+
+			auto create = FindSite(sites, Operation::create, createSite.m_Line);
+			REQUIRE(create);
+			CHECK(create->m_Counters.m_Calls == 1);
+			CHECK(create->m_Counters.m_Allocations == 1);
+
+			auto concat = FindSite(sites, Operation::concat, concatSite.m_Line);
+			REQUIRE(concat);
+			CHECK(concat->m_Counters.m_Calls == 1);
+
+			CHECK(sites.size() == 3);
+			CHECK(AllocationStatistics::Get(Operation::create).m_Calls == 2);
+
+			AllocationStatistics::Reset();
+			CHECK(AllocationStatistics::Sites().empty());
+		}
+
+		SECTION("Concat is counted.")
+		{
+			auto bv = ByteVector::Create(1);
+			bv.Concat(ByteVector::Create(2, 3), ByteVector::Create(4));
+			auto concat = AllocationStatistics::Get(Operation::concat);
+			CHECK(concat.m_Calls == 1);
+			CHECK(concat.m_Reallocations == 1);
+			CHECK(concat.m_BytesCopied == sizeof(int));
+		}
+	}
+}
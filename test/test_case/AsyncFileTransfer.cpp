@@ -0,0 +1,107 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/AsyncFile.h"
+#include "FSecure/ByteConverter/FrameCodec.h"
+
+#if defined(__linux__)
+
+#include <cstdlib>
+#include <sys/stat.h>
+
+using namespace FSecure;
+
+TEST_CASE("Asynchronous file transfer.")
+{
+	char path[] = "/tmp/ByteConverterXXXXXX";
+	auto descriptor = mkstemp(path);
+	REQUIRE(descriptor != -1);
+	unlink(path);
+
+	auto records = std::vector<ByteVector>{};
+	auto size = uint64_t{ 0 };
+	for (auto i = uint32_t{ 0 }; i < 500; ++i)
+	{
+		records.push_back(ByteVector::Create(i, std::string(i % 61, 'a')));
+		size += ByteVector::Size(ByteView{ records.back() });
+	}
+
+	auto backend = GENERATE(AsyncFileBackend::automatic, AsyncFileBackend::threads);
+
+	SECTION("Written frames are read back in order.")
+	{
+		{
+			auto sink = FileSink{ descriptor, 0, 8, 4, backend };
+			if (backend == AsyncFileBackend::threads)
+				CHECK(sink.Backend() == AsyncFileBackend::threads);
+
+			for (auto& record : records)
+				sink.Write(ByteView{ record });
+
+			sink.Flush();
+			CHECK(sink.Offset() == size);
+		}
+
+		struct stat status;
+		REQUIRE(fstat(descriptor, &status) == 0);
+		CHECK(static_cast<uint64_t>(status.st_size) == size);
+
+		for (auto blockSize : { size_t{ 7 }, size_t{ 256 }, size_t{ 64 * 1024 } })
+		{
+			auto source = FileSource{ descriptor, 0, blockSize, 3, backend };
+			auto decoder = FrameDecoder{};
+			auto received = size_t{ 0 };
+			while (auto block = source.Next())
+				decoder.Feed(*block, [&](ByteView frame) { CHECK(frame == ByteView{ records[received++] }); });
+
+			CHECK(received == records.size());
+			CHECK(decoder.Pending() == 0);
+			CHECK(!source.Next());
+		}
+	}
+
+	SECTION("Buffers of finished writes are recycled.")
+	{
+		auto sink = FileSink{ descriptor, 0, 4, 1, backend };
+		sink.Write(std::string(1000, 'b'));
+		sink.Flush();
+		auto buffer = sink.Recycle();
+		CHECK(buffer.empty());
+		CHECK(buffer.capacity() >= 1000);
+		CHECK(sink.Recycle().capacity() == 0);
+	}
+
+	SECTION("Objects are framed independently of their type.")
+	{
+		auto record = ByteVector::Create(uint32_t{ 7 });
+		{
+			auto sink = FileSink{ descriptor, 0, 4, 1, backend };
+			sink.Write(record);
+			sink.Write(ByteView{ record });
+			sink.Submit(ByteVector{ record });
+			sink.Flush();
+		}
+
+		auto source = FileSource{ descriptor, 0, 1024, 2, backend };
+		auto block = source.Next();
+		REQUIRE(block);
+		auto expected = ByteVector::Create(record, ByteView{ record }).Concat(record);
+		CHECK(ByteView{ *block } == ByteView{ expected });
+	}
+
+	SECTION("Source stops at the end of file.")
+	{
+		auto source = FileSource{ descriptor, 0, 16, 2, backend };
+		CHECK(!source.Next());
+	}
+
+	SECTION("Errors of writes are reported.")
+	{
+		auto sink = FileSink{ -1, 0, 4, 1, backend };
+		sink.Write(uint32_t{ 1 });
+		CHECK_THROWS_AS(sink.Flush(), std::system_error);
+	}
+
+	close(descriptor);
+}
+
+#endif
@@ -0,0 +1,95 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/ByteConverter.h"
+
+using namespace FSecure;
+
+namespace BufferOwnership
+{
+	/// Type whose converter creates new ByteVector.
+	struct Created
+	{
+		uint32_t m_Value;
+	};
+}
+
+namespace FSecure
+{
+	using namespace BufferOwnership;
+
+	template <>
+	struct ByteConverter<Created>
+	{
+		static ByteVector To(Created const& obj)
+		{
+			return ByteVector::Create(obj.m_Value);
+		}
+
+		constexpr static size_t Size()
+		{
+			return sizeof(uint32_t);
+		}
+
+		static Created From(ByteView& bv)
+		{
+			return { bv.Read<uint32_t>() };
+		}
+	};
+}
+
+TEST_CASE("Buffer ownership transfer.")
+{
+	SECTION("Adopt and release do not copy.")
+	{
+		auto buffer = std::vector<uint8_t>{ 1, 2, 3, 4 };
+		auto memory = buffer.data();
+		auto bv = ByteVector::Adopt(std::move(buffer));
+		CHECK(bv.data() == memory);
+		CHECK(bv.size() == 4);
+		CHECK(ByteView{ bv }.Read<uint8_t>() == 1);
+
+		auto released = bv.Release();
+		CHECK(released.data() == memory);
+		CHECK(released.size() == 4);
+		CHECK(bv.empty());
+		CHECK(bv.capacity() == 0);
+	}
+
+	SECTION("Concat of rvalue into empty ByteVector takes over buffer.")
+	{
+		auto payload = ByteVector::Create(uint32_t{ 7 }, std::string{ "text" });
+		auto expected = payload;
+		auto memory = payload.data();
+		auto bv = ByteVector{};
+		bv.Concat(std::move(payload));
+		CHECK(bv.data() == memory);
+		CHECK(bv == expected);
+		CHECK(payload.empty());
+	}
+
+	SECTION("Concat of rvalue keeps reserved memory.")
+	{
+		auto bv = ByteVector{};
+		bv.reserve(64);
+		auto memory = bv.data();
+		bv.Concat(ByteVector::Create(uint32_t{ 7 }));
+		CHECK(bv.data() == memory);
+		CHECK(bv.capacity() >= 64);
+
+		auto reserved = ByteVector{};
+		reserved.reserve(64);
+		memory = reserved.data();
+		reserved.Write(BufferOwnership::Created{ 5 });
+		CHECK(reserved.data() == memory);
+		CHECK(ByteView{ reserved }.Read<BufferOwnership::Created>().m_Value == 5);
+	}
+
+	SECTION("Concat of rvalue into non empty ByteVector appends.")
+	{
+		auto payload = ByteVector::Create(uint32_t{ 7 });
+		auto bv = ByteVector::Create(uint8_t{ 1 });
+		bv.Concat(std::move(payload)).Concat(ByteVector::Create(uint8_t{ 2 }));
+		CHECK(bv == ByteVector::Create(uint8_t{ 1 }, uint32_t{ 7 }, uint8_t{ 2 }));
+		CHECK(payload.empty());
+	}
+}
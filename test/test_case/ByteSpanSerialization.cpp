@@ -0,0 +1,141 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/ByteArrayWriter.h"
+
+using namespace FSecure;
+
+namespace ByteSpanSerialization
+{
+	struct Legacy
+	{
+		uint16_t m_A;
+		uint16_t m_B;
+
+		bool operator==(Legacy const& other) const
+		{
+			return m_A == other.m_A && m_B == other.m_B;
+		}
+	};
+}
+
+namespace FSecure
+{
+	using namespace ByteSpanSerialization;
+
+	/// Converter that expands only ByteVector, and has Size known at compile time.
+	template <>
+	struct ByteConverter<Legacy>
+	{
+		static void To(Legacy const& obj, ByteVector& bv)
+		{
+			bv.Write(obj.m_B, obj.m_A);
+		}
+
+		static constexpr size_t Size()
+		{
+			return 2 * sizeof(uint16_t);
+		}
+
+		static Legacy From(ByteView& bv)
+		{
+			auto [b, a] = bv.Read<uint16_t, uint16_t>();
+			return { a, b };
+		}
+	};
+}
+
+TEST_CASE("ByteSpan serialization.")
+{
+	using namespace ByteSpanSerialization;
+
+	SECTION("Writing to stack memory gives the same result as ByteVector.")
+	{
+		uint8_t memory[64];
+		auto span = ByteSpan{ memory, sizeof(memory) };
+		auto str = std::string{ "text" };
+		auto vec = std::vector<uint32_t>{ 1, 2, 3 };
+		auto var = std::variant<uint8_t, std::string>{ std::string{ "alt" } };
+		span.Write(uint32_t{ 7 }, str, vec, var, std::optional<uint64_t>{ 3 }, Legacy{ 1, 2 });
+		auto bv = ByteVector::Create(uint32_t{ 7 }, str, vec, var, std::optional<uint64_t>{ 3 }, Legacy{ 1, 2 });
+		CHECK(ByteView{ span } == ByteView{ bv });
+		CHECK(span.capacity() == sizeof(memory));
+	}
+
+	SECTION("Converter accepting only ByteVector allocates temporary buffer.")
+	{
+		uint8_t memory[64];
+		auto span = ByteSpan{ memory, sizeof(memory) };
+		AllocationStatistics::Reset();
+		AllocationStatistics::Enable();
+		span.Write(uint32_t{ 7 }, std::string{ "text" }, std::vector<uint32_t>{ 1, 2, 3 });
+		auto builtIn = AllocationStatistics::Get(AllocationStatistics::Operation::create);
+		span.Write(Legacy{ 1, 2 });
+		auto legacy = AllocationStatistics::Get(AllocationStatistics::Operation::create);
+		AllocationStatistics::Enable(false);
+		AllocationStatistics::Reset();
+
+		CHECK(builtIn.m_Allocations == 0);
+		CHECK(legacy.m_Calls == 1);
+		CHECK(legacy.m_Allocations == 1);
+	}
+
+	SECTION("Exceeding capacity throws, and keeps already written data.")
+	{
+		auto array = ByteArray<8>{};
+		auto span = ByteSpan{ array };
+		span.Write(uint32_t{ 1 });
+		CHECK_THROWS_AS(span.Write(uint16_t{ 2 }, uint32_t{ 3 }), std::out_of_range);
+		CHECK(span.size() == sizeof(uint32_t));
+		CHECK_THROWS_AS(span.Write(std::string{ "too long" }), std::out_of_range);
+		CHECK(span.size() == sizeof(uint32_t));
+		span.Write(uint32_t{ 2 });
+		CHECK(ByteView{ span } == ByteView{ ByteVector::Create(uint32_t{ 1 }, uint32_t{ 2 }) });
+	}
+
+	SECTION("ToByteArray with converter that is not constexpr.")
+	{
+		auto bytes = ToByteArray(uint8_t{ 9 }, Legacy{ 3, 4 }, uint16_t{ 5 });
+		static_assert(std::is_same_v<decltype(bytes), ByteArray<sizeof(uint8_t) + 2 * sizeof(uint16_t) + sizeof(uint16_t)>>);
+		CHECK(ByteView{ bytes } == ByteView{ ByteVector::Create(uint8_t{ 9 }, Legacy{ 3, 4 }, uint16_t{ 5 }) });
+	}
+
+	SECTION("FromByteArray.")
+	{
+		auto bytes = ToByteArray(uint32_t{ 10 }, Legacy{ 6, 7 });
+		auto [number, legacy] = FromByteArray<uint32_t, Legacy>(bytes);
+		CHECK(number == 10);
+		CHECK(legacy == Legacy{ 6, 7 });
+		CHECK(FromByteArray<uint32_t>(ToByteArray(uint32_t{ 11 })) == 11);
+	}
+
+	SECTION("WriteInto caller provided memory.")
+	{
+		auto str = std::string{ "frame" };
+		auto expected = ByteVector::Create(uint16_t{ 3 }, str, Legacy{ 8, 9 });
+
+		auto array = ByteArray<32>{};
+		CHECK(WriteInto(array, uint16_t{ 3 }, str, Legacy{ 8, 9 }) == expected.size());
+		CHECK(ByteView{ array.data(), expected.size() } == ByteView{ expected });
+
+		auto vec = std::vector<uint8_t>(expected.size());
+		CHECK(WriteInto(vec, uint16_t{ 3 }, str, Legacy{ 8, 9 }) == expected.size());
+		CHECK(ByteView{ vec.data(), vec.size() } == ByteView{ expected });
+
+		uint8_t raw[16] = {};
+		CHECK(WriteIntoMemory(raw + 1, sizeof(raw) - 1, uint32_t{ 1 }) == sizeof(uint32_t));
+		CHECK(raw[0] == 0);
+
+		// All arguments following buffer are serialized.
+		auto size = size_t{ 7 };
+		CHECK(WriteInto(raw, size, uint32_t{ 1 }) == sizeof(size_t) + sizeof(uint32_t));
+		CHECK(ByteView{ raw, sizeof(size_t) + sizeof(uint32_t) } == ByteView{ ByteVector::Create(size, uint32_t{ 1 }) });
+	}
+
+	SECTION("WriteInto too small memory throws before writing.")
+	{
+		auto array = ByteArray<8>{};
+		array.fill(0xAA);
+		CHECK_THROWS_AS(WriteInto(array, uint32_t{ 1 }, std::string{ "abc" }), std::out_of_range);
+		CHECK(std::all_of(array.begin(), array.end(), [](auto e) { return e == 0xAA; }));
+	}
+}
@@ -0,0 +1,138 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/ByteArrayWriter.h"
+
+using namespace FSecure;
+
+namespace ConstexprSerialization
+{
+	enum class Command : uint16_t { hello = 1, bye = 2 };
+
+	struct Header
+	{
+		uint32_t m_Magic;
+		Command m_Command;
+		bool m_Flag;
+	};
+
+	struct Converted
+	{
+		uint8_t m_A;
+		int64_t m_B;
+	};
+
+	/// Type, which converter writes different format than tuple returned by Convert.
+	struct Versioned
+	{
+		uint16_t m_Value;
+	};
+}
+
+namespace FSecure
+{
+	using namespace ConstexprSerialization;
+
+	template <>
+	struct ByteConverter<Header> : AggregateConverter<Header> {};
+
+	template <>
+	struct ByteConverter<Converted> : TupleConverter<Converted>
+	{
+		static constexpr auto Convert(Converted const& obj)
+		{
+			return std::make_tuple(obj.m_B, obj.m_A);
+		}
+	};
+
+	template <>
+	struct ByteConverter<Versioned> : TupleConverter<Versioned>
+	{
+		static constexpr auto Convert(Versioned const& obj)
+		{
+			return std::make_tuple(obj.m_Value);
+		}
+
+		template <typename Output>
+		static constexpr void To(Versioned const& obj, Output& bv)
+		{
+			bv.Store(uint8_t{ 2 }, obj.m_Value);
+		}
+
+		static constexpr size_t Size()
+		{
+			return sizeof(uint8_t) + sizeof(uint16_t);
+		}
+
+		static Versioned From(ByteView& bv)
+		{
+			auto [version, value] = bv.Read<uint8_t, uint16_t>();
+			return { static_cast<uint16_t>(value + version - 2) };
+		}
+	};
+}
+
+TEST_CASE("Constexpr serialization.")
+{
+	using namespace ConstexprSerialization;
+
+	SECTION("Arithmetic types and enums.")
+	{
+		static constexpr auto bytes = ToByteArray(uint32_t{ 0x01020304 }, int8_t{ -1 }, Command::bye, true, uint64_t{ 5 });
+		static_assert(bytes.size() == sizeof(uint32_t) + sizeof(int8_t) + sizeof(Command) + sizeof(bool) + sizeof(uint64_t));
+		auto bv = ByteVector::Create(uint32_t{ 0x01020304 }, int8_t{ -1 }, Command::bye, true, uint64_t{ 5 });
+		CHECK(ByteView{ bytes } == ByteView{ bv });
+	}
+
+#if defined(BYTE_CONVERTER_HAS_BIT_CAST)
+	SECTION("Floating point types.")
+	{
+		static constexpr auto bytes = ToByteArray(1.5f, -2.25);
+		auto bv = ByteVector::Create(1.5f, -2.25);
+		CHECK(ByteView{ bytes } == ByteView{ bv });
+	}
+#endif
+
+	SECTION("Containers, tuples and variants.")
+	{
+		using Variant = std::variant<uint16_t, int16_t>;
+		using Padded = PaddedVariant<uint8_t, uint32_t>;
+		static constexpr auto array = std::array<uint16_t, 3>{ 1, 2, 3 };
+		static constexpr auto tuple = std::make_tuple(uint8_t{ 1 }, std::pair<int32_t, Command>{ 2, Command::hello });
+		static constexpr auto bytes = ToByteArray(array, tuple, Variant{ int16_t{ -3 } }, Padded{ uint8_t{ 4 } });
+		auto bv = ByteVector::Create(array, tuple, Variant{ int16_t{ -3 } }, Padded{ uint8_t{ 4 } });
+		CHECK(ByteView{ bytes } == ByteView{ bv });
+
+		using Tuple = std::remove_const_t<decltype(tuple)>;
+		auto [readArray, readTuple, readVariant, readPadded] = ByteView{ bytes }.Read<std::array<uint16_t, 3>, Tuple, Variant, Padded>();
+		CHECK(readArray == array);
+		CHECK(readTuple == tuple);
+		CHECK(std::get<int16_t>(readVariant) == -3);
+		CHECK(std::get<uint8_t>(readPadded) == 4);
+	}
+
+	SECTION("Aggregates and TupleConverter.")
+	{
+		static constexpr auto header = Header{ 0xCAFE, Command::hello, true };
+		static constexpr auto converted = Converted{ 1, -2 };
+		static constexpr auto bytes = ToByteArray(header, converted);
+		auto bv = ByteVector::Create(header, converted);
+		CHECK(ByteView{ bytes } == ByteView{ bv });
+	}
+
+	SECTION("To of custom converter is used.")
+	{
+		static constexpr auto bytes = ToByteArray(Versioned{ 7 }, std::array<Versioned, 2>{ Versioned{ 8 }, Versioned{ 9 } });
+		static_assert(bytes[0] == 2);
+		auto bv = ByteVector::Create(Versioned{ 7 }, std::array<Versioned, 2>{ Versioned{ 8 }, Versioned{ 9 } });
+		CHECK(ByteView{ bytes } == ByteView{ bv });
+		CHECK(FromByteArray<Versioned>(ByteArray<3>{ bytes[0], bytes[1], bytes[2] }).m_Value == 7);
+	}
+
+	SECTION("ByteArrayWriter can be filled incrementally.")
+	{
+		constexpr auto writer = ByteArrayWriter<8>{}.Write(uint32_t{ 1 }).Write(uint16_t{ 2 });
+		static_assert(writer.size() == 6);
+		CHECK(ByteView{ writer.Get() }.Read<uint32_t, uint16_t>() == std::make_tuple(1u, uint16_t{ 2 }));
+		CHECK_THROWS(ByteArrayWriter<2>{}.Write(uint32_t{ 1 }));
+	}
+}
@@ -0,0 +1,88 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/Delta.h"
+
+#include <random>
+
+using namespace FSecure;
+
+namespace DeltaEncoding
+{
+	struct Entry
+	{
+		uint32_t m_Id;
+		uint64_t m_Counter;
+		std::string m_Name;
+	};
+}
+
+namespace FSecure
+{
+	template <>
+	struct ByteConverter<DeltaEncoding::Entry> : AggregateConverter<DeltaEncoding::Entry> {};
+}
+
+TEST_CASE("Delta encoding.")
+{
+	using namespace DeltaEncoding;
+
+	auto entries = std::vector<Entry>{};
+	for (auto i = uint32_t{ 0 }; i < 1000; ++i)
+		entries.push_back({ i, i * 10ull, "entry number " + std::to_string(i) });
+
+	auto base = ByteVector::Create(entries);
+
+	SECTION("Changed fixed size fields produce small delta.")
+	{
+		entries[10].m_Counter += 1;
+		entries[500].m_Counter += 1;
+		entries[501].m_Id = 7;
+		auto target = ByteVector::Create(entries);
+		REQUIRE(target.size() == base.size());
+
+		auto delta = Delta::Encode(base, target);
+		CHECK(delta.size() < 64);
+		CHECK(Delta::Apply(base, delta) == target);
+	}
+
+	SECTION("Inserted and removed data is matched.")
+	{
+		entries.insert(entries.begin() + 300, Entry{ 5000, 1, "inserted" });
+		entries.erase(entries.begin() + 700, entries.begin() + 710);
+		entries.push_back({ 6000, 2, "appended" });
+		auto target = ByteVector::Create(entries);
+		REQUIRE(target.size() != base.size());
+
+		auto delta = Delta::Encode(base, target);
+		CHECK(delta.size() < target.size() / 50);
+		CHECK(Delta::Apply(base, delta) == target);
+	}
+
+	SECTION("Unrelated and edge case buffers are rebuilt.")
+	{
+		auto random = std::mt19937{ 42 };
+		auto noise = ByteVector{};
+		for (auto i = 0; i < 5000; ++i)
+			noise.Write(static_cast<uint8_t>(random()));
+
+		for (auto [from, to] : { std::pair{ ByteView{ base }, ByteView{ noise } }, std::pair{ ByteView{ noise }, ByteView{ base } }, std::pair{ ByteView{}, ByteView{ base } }, std::pair{ ByteView{ base }, ByteView{} }, std::pair{ ByteView{ base }, ByteView{ base }.SubString(0, 3) } })
+			for (auto blockSize : { size_t{ 4 }, size_t{ 16 }, size_t{ 64 } })
+				CHECK(Delta::Apply(from, Delta::Encode(from, to, blockSize)) == ByteVector{ to });
+	}
+
+	SECTION("Identical buffers produce header only.")
+	{
+		auto delta = Delta::Encode(base, base);
+		CHECK(delta.size() == sizeof(uint8_t) + 3 * sizeof(uint32_t));
+		CHECK(Delta::Apply(base, delta) == base);
+	}
+
+	SECTION("Delta is rejected for different base.")
+	{
+		entries[0].m_Counter = 1;
+		auto target = ByteVector::Create(entries);
+		auto delta = Delta::Encode(base, target);
+		CHECK_THROWS_AS(Delta::Apply(target, delta), std::runtime_error);
+		CHECK_THROWS_AS(Delta::Apply(base, ByteView{ delta }.SubString(0, delta.size() - 1)), std::out_of_range);
+	}
+}
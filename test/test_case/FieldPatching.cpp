@@ -0,0 +1,112 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/Patch.h"
+
+using namespace FSecure;
+
+namespace FieldPatching
+{
+	struct Route
+	{
+		uint16_t m_Source;
+		uint16_t m_Destination;
+	};
+
+	struct Header
+	{
+		uint32_t m_Id;
+		Route m_Route;
+		uint8_t m_Hops;
+		uint64_t m_Timestamp;
+		std::string m_Body;
+	};
+
+	struct Sparse
+	{
+		uint32_t m_Id = 0;
+		std::optional<std::string> m_Note;
+		uint8_t m_Hops = 0;
+	};
+}
+
+namespace FSecure
+{
+	using namespace FieldPatching;
+
+	template <>
+	struct ByteConverter<Route> : AggregateConverter<Route> {};
+
+	template <>
+	struct ByteConverter<Header> : AggregateConverter<Header> {};
+
+	template <>
+	struct ByteConverter<Sparse> : PointerTupleConverter<Sparse>
+	{
+		static auto MemberPointers()
+		{
+			return std::make_tuple(&Sparse::m_Id, &Sparse::m_Hops, &Sparse::m_Note);
+		}
+	};
+}
+
+TEST_CASE("Field patching.")
+{
+	SECTION("Offsets are computed at compilation time.")
+	{
+		static_assert(FieldOffset<Header, 0>() == 0);
+		static_assert(FieldOffset<Header, 2>() == sizeof(uint32_t) + 2 * sizeof(uint16_t));
+		static_assert(FieldOffset<Header, 4>() == sizeof(uint32_t) + 2 * sizeof(uint16_t) + sizeof(uint8_t) + sizeof(uint64_t));
+		static_assert(FieldOffset<Sparse, 1>() == 1 + sizeof(uint32_t));
+		static_assert(FieldOffset<std::tuple<uint8_t, uint32_t, uint16_t>, 2>() == 5);
+		static_assert(std::is_same_v<FieldType<Header, 3>, uint64_t>);
+	}
+
+	SECTION("Fields are overwritten in place.")
+	{
+		auto header = Header{ 1, { 10, 20 }, 3, 1000, "body" };
+		auto prefix = std::string{ "prefix" };
+		auto bv = ByteVector::Create(prefix, header);
+		auto position = ByteVector::Size(prefix);
+		auto data = bv.data();
+
+		Patch<Header, 2>(bv, 4, position);
+		Patch<Header, 3>(bv, 2000, position);
+		Patch<Route, 1>(bv, 30, position + FieldOffset<Header, 1>());
+		CHECK(bv.data() == data);
+
+		auto [readPrefix, read] = ByteView{ bv }.Read<std::string, Header>();
+		CHECK(readPrefix == prefix);
+		CHECK(read.m_Id == 1);
+		CHECK(read.m_Route.m_Source == 10);
+		CHECK(read.m_Route.m_Destination == 30);
+		CHECK(read.m_Hops == 4);
+		CHECK(read.m_Timestamp == 2000);
+		CHECK(read.m_Body == "body");
+	}
+
+	SECTION("Presence bitmap is taken into account.")
+	{
+		auto bv = ByteVector::Create(Sparse{ 7, "note", 1 });
+		Patch<Sparse, 1>(bv, 2);
+		auto read = ByteView{ bv }.Read<Sparse>();
+		CHECK(read.m_Id == 7);
+		CHECK(read.m_Hops == 2);
+		CHECK(read.m_Note == "note");
+	}
+
+	SECTION("Other buffers can be patched.")
+	{
+		auto array = ByteArray<3>{};
+		WriteInto(array, std::tuple<uint8_t, uint16_t>{ 1, 2 });
+		Patch<std::tuple<uint8_t, uint16_t>, 1>(array, 0x0302);
+		CHECK(ByteView{ array }.Read<uint8_t, uint16_t>() == std::tuple<uint8_t, uint16_t>{ 1, 0x0302 });
+	}
+
+	SECTION("Field outside of buffer is rejected.")
+	{
+		auto bv = ByteVector::Create(uint32_t{ 1 }, uint8_t{ 2 });
+		CHECK_THROWS_AS((Patch<std::tuple<uint32_t, uint8_t>, 1>(bv, 3, 1)), std::out_of_range);
+		CHECK_THROWS_AS((Patch<std::tuple<uint32_t, uint8_t>, 0>(bv, 3, 10)), std::out_of_range);
+		CHECK(ByteView{ bv }.Read<uint32_t, uint8_t>() == std::tuple<uint32_t, uint8_t>{ 1, 2 });
+	}
+}
@@ -0,0 +1,93 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/FrameCodec.h"
+
+#if defined(BYTE_CONVERTER_HAS_POSIX_IO)
+#	include <fcntl.h>
+#	include <sys/socket.h>
+#endif
+
+using namespace FSecure;
+
+TEST_CASE("Frame codec transfer.")
+{
+	auto stream = ByteVector{};
+	auto frames = std::vector<ByteVector>{};
+	for (auto i = uint32_t{ 0 }; i < 100; ++i)
+	{
+		frames.push_back(ByteVector::Create(i, std::string(i % 17, 'f')));
+		stream.Write(ByteView{ frames.back() });
+	}
+
+	SECTION("Frames of contiguous chunk are not copied.")
+	{
+		auto decoder = FrameDecoder{};
+		auto received = size_t{ 0 };
+		auto inPlace = true;
+		auto view = ByteView{ stream };
+		CHECK(decoder.Feed(view, [&](ByteView frame)
+			{
+				inPlace &= frame.data() >= view.data() && frame.data() + frame.size() <= view.data() + view.size();
+				CHECK(frame == ByteView{ frames[received++] });
+			}) == frames.size());
+
+		CHECK(inPlace);
+		CHECK(received == frames.size());
+		CHECK(decoder.Pending() == 0);
+	}
+
+	SECTION("Frames split between chunks are assembled.")
+	{
+		for (auto chunkSize : { size_t{ 1 }, size_t{ 3 }, size_t{ 7 }, size_t{ 64 } })
+		{
+			auto decoder = FrameDecoder{};
+			auto received = size_t{ 0 };
+			for (auto view = ByteView{ stream }; !view.empty(); view.remove_prefix((std::min)(chunkSize, view.size())))
+				decoder.Feed(view.SubString(0, chunkSize), [&](ByteView frame) { CHECK(frame == ByteView{ frames[received++] }); });
+
+			CHECK(received == frames.size());
+			CHECK(decoder.Pending() == 0);
+		}
+	}
+
+	SECTION("Too large frame is rejected.")
+	{
+		auto decoder = FrameDecoder{ 8 };
+		CHECK_THROWS_AS(decoder.Feed(ByteVector::Create(ByteView{ stream }), [](ByteView) {}), std::out_of_range);
+	}
+
+#if defined(BYTE_CONVERTER_HAS_POSIX_IO)
+	SECTION("Frames are passed over socketpair.")
+	{
+		int sockets[2];
+		REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0);
+		fcntl(sockets[0], F_SETFL, fcntl(sockets[0], F_GETFL) | O_NONBLOCK);
+		fcntl(sockets[1], F_SETFL, fcntl(sockets[1], F_GETFL) | O_NONBLOCK);
+
+		auto encoder = FrameEncoder{};
+		auto decoder = FrameDecoder{ 1024 * 1024, 1000 };
+		auto received = std::vector<ByteVector>{};
+		auto large = ByteVector::Create(std::vector<uint64_t>(100000, 5));
+		for (auto& frame : frames)
+			encoder.Push(frame);
+
+		encoder.Push(ByteVector{ large }).Write(uint32_t{ 1 }, std::string{ "last" });
+		CHECK(encoder.Frames() == frames.size() + 2);
+
+		// Socket buffer is smaller than large frame, so writes are partial.
+		while (!encoder.Flush(sockets[0]) || decoder.Pending())
+			while (decoder.ReadFrom(sockets[1], [&](ByteView frame) { received.push_back(frame); }));
+
+		while (decoder.ReadFrom(sockets[1], [&](ByteView frame) { received.push_back(frame); }));
+		CHECK(encoder.Pending() == 0);
+		REQUIRE(received.size() == frames.size() + 2);
+		CHECK(std::equal(frames.begin(), frames.end(), received.begin()));
+		CHECK(received[frames.size()] == large);
+		CHECK(ByteView{ received.back() }.Read<uint32_t, std::string>() == std::make_tuple(uint32_t{ 1 }, std::string{ "last" }));
+
+		close(sockets[0]);
+		CHECK(decoder.ReadFrom(sockets[1], [](ByteView) {}) == size_t{ 0 });
+		close(sockets[1]);
+	}
+#endif
+}
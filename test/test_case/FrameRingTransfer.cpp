@@ -0,0 +1,132 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/FrameRing.h"
+
+#include <thread>
+
+using namespace FSecure;
+
+TEST_CASE("FrameRing transfer.")
+{
+	SECTION("Frames are read in place in order of commit.")
+	{
+		auto ring = FrameRing<false>{ 256 };
+		CHECK(ring.Empty());
+		CHECK(ring.TryWrite(uint32_t{ 1 }, std::string{ "first" }));
+		auto reservation = ring.Reserve(64);
+		REQUIRE(reservation);
+		reservation->Write(uint16_t{ 2 });
+		ring.Commit(*reservation);
+
+		auto first = ring.Next();
+		REQUIRE(first);
+		CHECK(first->Read<uint32_t, std::string>() == std::make_tuple(uint32_t{ 1 }, std::string{ "first" }));
+		auto second = ring.Next();
+		REQUIRE(second);
+		CHECK(second->size() == sizeof(uint16_t));
+		CHECK(second->Read<uint16_t>() == 2);
+		CHECK_FALSE(ring.Next());
+		CHECK_FALSE(ring.Empty());
+		ring.Release();
+		CHECK(ring.Empty());
+	}
+
+	SECTION("Uncommitted frame blocks following frames.")
+	{
+		auto ring = FrameRing<true>{ 256 };
+		auto first = ring.Reserve(8);
+		auto second = ring.Reserve(8);
+		REQUIRE((first && second));
+		second->Write(uint64_t{ 2 });
+		ring.Commit(*second);
+		CHECK_FALSE(ring.Next());
+		first->Write(uint64_t{ 1 });
+		ring.Commit(*first);
+		CHECK(ring.Next()->Read<uint64_t>() == 1);
+		CHECK(ring.Next()->Read<uint64_t>() == 2);
+	}
+
+	SECTION("Batch commit, abandon and consume.")
+	{
+		auto ring = FrameRing<false>{ 1024 };
+		auto batch = std::vector<FrameRing<false>::Reservation>{};
+		for (auto i = uint32_t{ 0 }; i < 4; ++i)
+			batch.push_back(*ring.Reserve(sizeof(uint32_t)));
+
+		for (auto i = uint32_t{ 0 }; i < 4; ++i)
+			batch[i].Write(i);
+
+		auto abandoned = ring.Reserve(16);
+		ring.Abandon(*abandoned);
+		ring.Commit(batch.begin(), batch.end());
+		auto values = std::vector<uint32_t>{};
+		CHECK(ring.Consume([&](ByteView frame) { values.push_back(frame.Read<uint32_t>()); }) == 4);
+		CHECK(values == std::vector<uint32_t>{ 0, 1, 2, 3 });
+		CHECK(ring.Empty());
+	}
+
+	SECTION("Full ring and wraparound.")
+	{
+		auto ring = FrameRing<false>{ 128 };
+		CHECK_THROWS_AS(ring.Reserve(ring.MaxFrameSize() + 1), std::invalid_argument);
+		CHECK_THROWS_AS(FrameRing<false>{ 100 }, std::invalid_argument);
+		for (auto lap = 0; lap < 50; ++lap)
+		{
+			auto payload = std::string(static_cast<size_t>(lap % 37), static_cast<char>('a' + lap % 26));
+			while (!ring.TryWrite(payload))
+				CHECK(ring.Consume([](ByteView) {}) > 0);
+
+			if (lap % 3 == 0)
+				ring.Consume([&](ByteView frame) { CHECK(frame.Read<std::string>().size() < 37); });
+		}
+
+		ring.Consume([](ByteView) {});
+		CHECK(ring.Empty());
+	}
+
+	SECTION("External memory.")
+	{
+		alignas(64) uint8_t memory[FrameRing<true>::RequiredMemory(256)];
+		auto producer = FrameRing<true>{ memory, 256, true };
+		auto consumer = FrameRing<true>{ memory, 256, false };
+		CHECK(producer.TryWrite(std::string{ "shared" }));
+		CHECK(consumer.Next()->Read<std::string>() == "shared");
+		consumer.Release();
+		CHECK(producer.Empty());
+		CHECK_THROWS_AS((FrameRing<true>{ memory + 8, 128, true }), std::invalid_argument);
+	}
+
+	SECTION("Multiple producers.")
+	{
+		constexpr auto producers = uint32_t{ 4 };
+		constexpr auto messages = uint32_t{ 20000 };
+		auto ring = FrameRing<true>{ 4096 };
+		auto threads = std::vector<std::thread>{};
+		for (auto id = uint32_t{ 0 }; id < producers; ++id)
+			threads.emplace_back([&ring, id]
+				{
+					for (auto i = uint32_t{ 0 }; i < messages; ++i)
+						while (!ring.TryWrite(id, i, std::vector<uint8_t>(i % 50, static_cast<uint8_t>(i))))
+							std::this_thread::yield();
+				});
+
+		auto expected = std::vector<uint32_t>(producers, 0);
+		auto received = uint32_t{ 0 };
+		auto ordered = true;
+		while (received < producers * messages)
+		{
+			received += static_cast<uint32_t>(ring.Consume([&](ByteView frame)
+				{
+					auto [id, i, data] = frame.Read<uint32_t, uint32_t, std::vector<uint8_t>>();
+					ordered &= expected[id]++ == i && data.size() == i % 50 && (data.empty() || data.back() == static_cast<uint8_t>(i));
+				}, 64));
+		}
+
+		for (auto& thread : threads)
+			thread.join();
+
+		CHECK(ordered);
+		CHECK(expected == std::vector<uint32_t>(producers, messages));
+		CHECK(ring.Empty());
+	}
+}
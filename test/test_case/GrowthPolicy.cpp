@@ -0,0 +1,78 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/ByteConverter.h"
+
+using namespace FSecure;
+
+namespace GrowthPolicy
+{
+	/// Count how many times capacity of ByteVector changes while performing write operation.
+	template <typename Write>
+	size_t CountReallocations(ByteVector& bv, size_t count, Write&& write)
+	{
+		auto reallocations = size_t{ 0 };
+		for (auto i = size_t{ 0 }; i < count; ++i)
+		{
+			auto capacity = bv.capacity();
+			write(bv, i);
+			reallocations += bv.capacity() != capacity;
+		}
+
+		return reallocations;
+	}
+}
+
+TEST_CASE("Growth policy.")
+{
+	using namespace GrowthPolicy;
+	constexpr auto count = size_t{ 1000 };
+
+	SECTION("Chained writes grow geometrically.")
+	{
+		auto bv = ByteVector{};
+		auto reallocations = CountReallocations(bv, count, [](ByteVector& bv, size_t i) { bv.Write(static_cast<uint32_t>(i)); });
+		CHECK(reallocations <= 12);
+		CHECK(bv.size() == count * sizeof(uint32_t));
+	}
+
+	SECTION("Exact policy reserves only required space.")
+	{
+		auto bv = ByteVector{};
+		auto reallocations = CountReallocations(bv, count, [](ByteVector& bv, size_t i) { bv.Write<ByteVector::GrowthPolicy::exact>(static_cast<uint32_t>(i)); });
+		CHECK(reallocations == count);
+		CHECK(bv.capacity() == bv.size());
+	}
+
+	SECTION("Both policies produce the same data.")
+	{
+		auto geometric = ByteVector{}, exact = ByteVector{};
+		for (auto i = 0; i < 10; ++i)
+		{
+			geometric.Write(i, std::to_string(i));
+			exact.Write<ByteVector::GrowthPolicy::exact>(i, std::to_string(i));
+		}
+
+		CHECK(geometric == exact);
+	}
+
+	SECTION("Builder assembles message and optionally shrinks it.")
+	{
+		auto builder = ByteVector::Builder{ 16 };
+		for (auto i = 0; i < 100; ++i)
+			builder.Write(i, std::string{ "element" });
+
+		builder.Concat(ByteVector::Create(7), ByteView{ ByteVector::Create(8) });
+		auto size = builder.Size();
+		auto message = builder.Finish(true);
+
+		CHECK(message.size() == size);
+		CHECK(message.capacity() == message.size());
+		CHECK(builder.Size() == 0);
+
+		auto view = ByteView{ message };
+		for (auto i = 0; i < 100; ++i)
+			REQUIRE(view.Read<int, std::string>() == std::make_tuple(i, std::string{ "element" }));
+
+		CHECK(view.Read<int, int>() == std::make_tuple(7, 8));
+	}
+}
@@ -0,0 +1,156 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/ByteConverter.h"
+
+#include <map>
+#include <memory_resource>
+
+using namespace FSecure;
+
+namespace MemoryResourceSerialization
+{
+	/// Resource counting allocations forwarded to upstream.
+	class CountingResource : public std::pmr::memory_resource
+	{
+	public:
+		size_t m_Allocations = 0;
+
+	private:
+		void* do_allocate(size_t bytes, size_t alignment) override
+		{
+			++m_Allocations;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void* p, size_t bytes, size_t alignment) override
+		{
+			std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+		}
+
+		bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+		{
+			return this == &other;
+		}
+	};
+
+	/// Structure with members using polymorphic allocator.
+	struct Record
+	{
+		uint32_t m_Id = 0;
+		std::pmr::string m_Name;
+		std::pmr::vector<std::pmr::string> m_Tags;
+		std::array<std::pmr::string, 2> m_Pair;
+	};
+
+	/// Makes resource default, until it is destroyed.
+	class DefaultResource
+	{
+	public:
+		explicit DefaultResource(std::pmr::memory_resource& resource)
+			: m_Previous{ std::pmr::set_default_resource(&resource) }
+		{
+		}
+
+		~DefaultResource()
+		{
+			std::pmr::set_default_resource(m_Previous);
+		}
+
+	private:
+		std::pmr::memory_resource* m_Previous;
+	};
+}
+
+namespace FSecure
+{
+	using namespace MemoryResourceSerialization;
+
+	template <>
+	struct ByteConverter<Record> : PointerTupleConverter<Record>
+	{
+		static auto MemberPointers()
+		{
+			return std::make_tuple(&Record::m_Id, &Record::m_Name, &Record::m_Tags, &Record::m_Pair);
+		}
+	};
+}
+
+TEST_CASE("Memory resource serialization.")
+{
+	using namespace MemoryResourceSerialization;
+	using Strings = std::pmr::vector<std::pmr::string>;
+	using Map = std::pmr::map<std::pmr::string, std::pmr::vector<int>>;
+
+	auto strings = std::vector<std::string>{ "first string that does not fit small buffer", "second string that does not fit small buffer" };
+	auto map = std::map<std::string, std::vector<int>>{ { "key that does not fit small buffer", { 1, 2, 3 } }, { "b", { 4 } } };
+	auto bv = ByteVector::Create(strings, map, uint32_t{ 5 });
+
+	SECTION("All containers use provided resource.")
+	{
+		char buffer[4096];
+		auto arena = std::pmr::monotonic_buffer_resource{ buffer, sizeof(buffer), std::pmr::null_memory_resource() };
+		auto [readStrings, readMap, number] = ByteView{ bv }.Read<Strings, Map, uint32_t>(arena);
+
+		CHECK(readStrings.get_allocator().resource() == &arena);
+		CHECK(readMap.get_allocator().resource() == &arena);
+		REQUIRE(readStrings.size() == strings.size());
+		CHECK(readStrings[0].get_allocator().resource() == &arena);
+		CHECK(readStrings[1] == strings[1].c_str());
+		CHECK(readMap.begin()->first.get_allocator().resource() == &arena);
+		CHECK(readMap.begin()->second.get_allocator().resource() == &arena);
+		CHECK(readMap.size() == map.size());
+		CHECK(number == 5);
+	}
+
+	SECTION("Default resource is used outside of scope.")
+	{
+		auto counting = CountingResource{};
+		auto readStrings = ByteView{ bv }.Read<Strings>(counting);
+		CHECK(counting.m_Allocations >= 3);
+		CHECK(Utils::Container::MemoryResourceScope::Get() == std::pmr::get_default_resource());
+
+		auto defaultStrings = ByteView{ bv }.Read<Strings>();
+		CHECK(defaultStrings.get_allocator().resource() == std::pmr::get_default_resource());
+		CHECK(defaultStrings == readStrings);
+	}
+
+	SECTION("Scopes can be nested.")
+	{
+		auto outer = CountingResource{};
+		auto inner = CountingResource{};
+		auto outerScope = Utils::Container::MemoryResourceScope{ outer };
+		{
+			auto innerScope = Utils::Container::MemoryResourceScope{ inner };
+			CHECK(Utils::Container::MemoryResourceScope::Get() == &inner);
+		}
+
+		CHECK(Utils::Container::MemoryResourceScope::Get() == &outer);
+		auto readStrings = ByteView{ bv }.Read<Strings>();
+		CHECK(readStrings.get_allocator().resource() == &outer);
+		CHECK(inner.m_Allocations == 0);
+	}
+
+	SECTION("Members of structures use provided resource.")
+	{
+		auto longString = std::string(64, 'x');
+		auto record = ByteVector::Create(uint32_t{ 3 }, longString, std::vector<std::string>{ longString, longString }, std::array<std::string, 2>{ longString, longString });
+
+		auto upstream = CountingResource{};
+		auto defaultResource = CountingResource{};
+		char buffer[4096];
+		auto arena = std::pmr::monotonic_buffer_resource{ buffer, sizeof(buffer), &upstream };
+		auto scope = DefaultResource{ defaultResource };
+		auto read = ByteView{ record }.Read<Record>(arena);
+
+		CHECK(read.m_Id == 3);
+		CHECK(read.m_Name == longString.c_str());
+		CHECK(read.m_Name.get_allocator().resource() == &arena);
+		CHECK(read.m_Tags.get_allocator().resource() == &arena);
+		REQUIRE(read.m_Tags.size() == 2);
+		CHECK(read.m_Tags[1].get_allocator().resource() == &arena);
+		CHECK(read.m_Pair[1] == longString.c_str());
+		CHECK(read.m_Pair[1].get_allocator().resource() == &arena);
+		CHECK(upstream.m_Allocations == 0);
+		CHECK(defaultResource.m_Allocations == 0);
+	}
+}
@@ -0,0 +1,116 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/ByteConverter.h"
+
+using namespace FSecure;
+
+namespace NullableSerialization
+{
+	struct Sparse
+	{
+		uint32_t m_Id = 0;
+		std::optional<uint64_t> m_A;
+		std::optional<std::string> m_B;
+		std::unique_ptr<std::vector<int>> m_C;
+		std::shared_ptr<uint16_t const> m_D;
+		std::optional<uint8_t> m_E;
+		std::optional<uint8_t> m_F;
+		std::optional<uint8_t> m_G;
+		std::optional<uint8_t> m_H;
+		std::optional<uint8_t> m_I;
+
+		bool operator==(Sparse const& other) const
+		{
+			auto same = [](auto const& a, auto const& b) { return static_cast<bool>(a) == static_cast<bool>(b) && (!a || *a == *b); };
+			return m_Id == other.m_Id && m_A == other.m_A && m_B == other.m_B && same(m_C, other.m_C) && same(m_D, other.m_D)
+				&& m_E == other.m_E && m_F == other.m_F && m_G == other.m_G && m_H == other.m_H && m_I == other.m_I;
+		}
+	};
+}
+
+namespace FSecure
+{
+	using namespace NullableSerialization;
+
+	template <>
+	struct ByteConverter<Sparse> : PointerTupleConverter<Sparse>
+	{
+		static auto MemberPointers()
+		{
+			return std::make_tuple(&Sparse::m_Id, &Sparse::m_A, &Sparse::m_B, &Sparse::m_C, &Sparse::m_D,
+				&Sparse::m_E, &Sparse::m_F, &Sparse::m_G, &Sparse::m_H, &Sparse::m_I);
+		}
+	};
+}
+
+TEST_CASE("Nullable serialization.")
+{
+	using namespace NullableSerialization;
+
+	SECTION("Presence marker takes one byte.")
+	{
+		CHECK(ByteVector::Create(std::optional<uint32_t>{}).size() == 1);
+		CHECK(ByteVector::Create(std::optional<uint32_t>{ 5 }).size() == 1 + sizeof(uint32_t));
+		CHECK(ByteVector::Size(std::make_unique<std::string>("abc")) == 1 + sizeof(uint32_t) + 3);
+		CHECK(ByteVector::Size(std::shared_ptr<int>{}) == 1);
+	}
+
+	SECTION("Round trip of standalone nullable types.")
+	{
+		auto bv = ByteVector::Create(std::optional<std::string>{ "text" }, std::optional<int>{}, std::make_unique<int>(7), std::shared_ptr<std::string>{}, std::make_shared<uint8_t>(uint8_t{ 3 }));
+		auto [a, b, c, d, e] = ByteView{ bv }.Read<std::optional<std::string>, std::optional<int>, std::unique_ptr<int>, std::shared_ptr<std::string>, std::shared_ptr<uint8_t>>();
+		CHECK(a == "text");
+		CHECK(!b);
+		REQUIRE(c);
+		CHECK(*c == 7);
+		CHECK(!d);
+		REQUIRE(e);
+		CHECK(*e == 3);
+	}
+
+	SECTION("ReadInto reuses held values.")
+	{
+		auto target = std::make_unique<std::string>(100, 'x');
+		auto held = target.get();
+		auto bv = ByteVector::Create(std::make_unique<std::string>("abc"), std::optional<int>{});
+		auto other = std::optional<int>{ 1 };
+		ByteView{ bv }.ReadInto(target, other);
+		CHECK(target.get() == held);
+		CHECK(*target == "abc");
+		CHECK(!other);
+	}
+
+	SECTION("Members share presence bitmap.")
+	{
+		auto empty = Sparse{};
+		empty.m_Id = 1;
+		auto emptySize = sizeof(uint32_t) + 2; // 9 nullable members take two bytes of bitmap.
+		CHECK(ByteVector::Size(empty) == emptySize);
+		CHECK(ByteVector::Create(empty).size() == emptySize);
+		CHECK(ByteView{ ByteVector::Create(empty) }.Read<Sparse>() == empty);
+
+		auto full = Sparse{ 2, 3, "b", std::make_unique<std::vector<int>>(std::vector<int>{ 4, 5 }), std::make_shared<uint16_t const>(uint16_t{ 6 }), 7, 8, 9, 10, 11 };
+		auto bv = ByteVector::Create(full);
+		CHECK(bv.size() == ByteVector::Size(full));
+		CHECK(bv.size() == emptySize + sizeof(uint64_t) + ByteVector::Size(std::string{ "b" }) + ByteVector::Size(std::vector<int>{ 4, 5 }) + sizeof(uint16_t) + 5);
+		CHECK(ByteView{ bv }.Read<Sparse>() == full);
+
+		auto partial = Sparse{};
+		partial.m_B = "only";
+		partial.m_I = 1;
+		CHECK(ByteView{ ByteVector::Create(partial) }.Read<Sparse>() == partial);
+	}
+
+	SECTION("ReadInto of type with presence bitmap.")
+	{
+		auto source = Sparse{};
+		source.m_C = std::make_unique<std::vector<int>>(std::vector<int>{ 1 });
+		source.m_H = 4;
+		auto target = Sparse{ 2, 3, "b", std::make_unique<std::vector<int>>(10), nullptr, 7, 8, 9, 10, 11 };
+		auto held = target.m_C.get();
+		auto bv = ByteVector::Create(source);
+		ByteView{ bv }.ReadInto(target);
+		CHECK(target == source);
+		CHECK(target.m_C.get() == held);
+	}
+}
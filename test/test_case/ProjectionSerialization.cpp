@@ -0,0 +1,194 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/TaggedConverter.h"
+
+using namespace FSecure;
+
+namespace ProjectionSerialization
+{
+	/// Counts constructions, to check that skipped members are never built.
+	struct Counted
+	{
+		inline static size_t s_Constructions = 0;
+
+		Counted() = default;
+
+		Counted(std::string text)
+			: m_Text{ std::move(text) }
+		{
+			++s_Constructions;
+		}
+
+		std::string m_Text;
+	};
+
+	struct Record
+	{
+		uint32_t m_Id = 0;
+		std::vector<Counted> m_Notes;
+		std::optional<std::map<std::string, uint64_t>> m_Counters;
+		std::string m_Name = "unnamed";
+		std::variant<uint8_t, Counted> m_Payload;
+		uint16_t m_Port = 0;
+	};
+
+	struct Plain
+	{
+		uint32_t m_a;
+		std::vector<Counted> m_b;
+		std::string m_c;
+	};
+
+	struct Tagged
+	{
+		uint32_t m_Id = 0;
+		std::vector<Counted> m_Notes;
+		std::string m_Name;
+	};
+}
+
+namespace FSecure
+{
+	using namespace ProjectionSerialization;
+
+	template <>
+	struct ByteConverter<Counted>
+	{
+		template <typename Output>
+		static void To(Counted const& obj, Output& bv)
+		{
+			bv.Store(obj.m_Text);
+		}
+
+		static size_t Size(Counted const& obj)
+		{
+			return ByteVector::Size(obj.m_Text);
+		}
+
+		static Counted From(ByteView& bv)
+		{
+			return { bv.Read<std::string>() };
+		}
+
+		static void Skip(ByteView& bv)
+		{
+			bv.Skip<std::string>();
+		}
+	};
+
+	template <>
+	struct ByteConverter<Record> : PointerTupleConverter<Record>
+	{
+		static auto MemberPointers()
+		{
+			return std::make_tuple(&Record::m_Id, &Record::m_Notes, &Record::m_Counters, &Record::m_Name, &Record::m_Payload, &Record::m_Port);
+		}
+
+		static void Skip(ByteView& bv)
+		{
+			SkipMembers(bv);
+		}
+	};
+
+	template <>
+	struct ByteConverter<Plain> : AggregateConverter<Plain> {};
+
+	template <>
+	struct ByteConverter<Tagged> : TaggedConverter<Tagged>
+	{
+		static auto TaggedMembers()
+		{
+			return std::make_tuple(TaggedMember{ 1, &Tagged::m_Id }, TaggedMember{ 2, &Tagged::m_Notes }, TaggedMember{ 3, &Tagged::m_Name });
+		}
+	};
+}
+
+TEST_CASE("Projection serialization.")
+{
+	auto notes = std::vector<Counted>{ { "first" }, { "second" }, { "third" } };
+	auto record = Record{ 42, notes, std::map<std::string, uint64_t>{ { "a", 1 }, { "b", 2 } }, "record", Counted{ "payload" }, 8080 };
+	auto bv = ByteVector::Create(record, uint8_t{ 7 });
+	Counted::s_Constructions = 0;
+
+	SECTION("Skipped objects are not constructed.")
+	{
+		auto view = ByteView{ bv };
+		view.Skip<Record>();
+		CHECK(view.Read<uint8_t>() == 7);
+		CHECK(view.empty());
+		CHECK(Counted::s_Constructions == 0);
+	}
+
+	SECTION("Skipping standard types.")
+	{
+		auto data = ByteVector::Create(std::vector<uint32_t>{ 1, 2, 3 }, std::optional<std::string>{ "text" }, std::optional<std::string>{}, std::tuple<uint8_t, std::string>{ 1, "t" }, std::variant<uint8_t, std::string>{ "v" }, std::map<std::string, std::vector<uint16_t>>{ { "k", { 1 } } }, uint8_t{ 9 });
+		auto view = ByteView{ data };
+		view.Skip<std::vector<uint32_t>, std::optional<std::string>, std::optional<std::string>, std::tuple<uint8_t, std::string>, std::variant<uint8_t, std::string>>();
+		view.Skip<std::map<std::string, std::vector<uint16_t>>>();
+		CHECK(view.Read<uint8_t>() == 9);
+		CHECK(view.empty());
+	}
+
+	SECTION("Skipping truncated data throws and restores view.")
+	{
+		auto view = ByteView{ bv }.SubString(0, bv.size() - 3);
+		auto size = view.size();
+		CHECK_THROWS_AS(view.Skip<Record>(), std::out_of_range);
+		CHECK(view.size() == size);
+	}
+
+	SECTION("Project returns selected members.")
+	{
+		auto view = ByteView{ bv };
+		auto [name, id, port] = view.Read<Project<&Record::m_Name, &Record::m_Id, &Record::m_Port>>();
+		CHECK(name == "record");
+		CHECK(id == 42);
+		CHECK(port == 8080);
+		CHECK(view.Read<uint8_t>() == 7);
+		CHECK(Counted::s_Constructions == 0);
+
+		CHECK(ByteView{ bv }.Read<Project<&Record::m_Counters>>()->at("b") == 2);
+	}
+
+	SECTION("Partial returns object with selected members.")
+	{
+		auto partial = ByteView{ bv }.Read<Partial<&Record::m_Notes, &Record::m_Port>>();
+		CHECK(partial.m_Id == 0);
+		CHECK(partial.m_Notes.size() == 3);
+		CHECK(partial.m_Notes[2].m_Text == "third");
+		CHECK(!partial.m_Counters);
+		CHECK(partial.m_Name == "unnamed");
+		CHECK(partial.m_Port == 8080);
+		CHECK(Counted::s_Constructions == 3);
+	}
+
+	SECTION("Projection leaves other members of existing object untouched.")
+	{
+		auto target = Record{};
+		target.m_Name = "kept";
+		auto view = ByteView{ bv };
+		ByteConverter<Record>::ReadProjection<&Record::m_Id>(view, target);
+		CHECK(target.m_Id == 42);
+		CHECK(target.m_Name == "kept");
+		CHECK(view.size() == 1);
+	}
+
+	SECTION("Aggregates are projected.")
+	{
+		auto data = ByteVector::Create(Plain{ 5, notes, "plain" });
+		auto [a, c] = ByteView{ data }.Read<Project<&Plain::m_a, &Plain::m_c>>();
+		CHECK(a == 5);
+		CHECK(c == "plain");
+		CHECK(Counted::s_Constructions == 0);
+	}
+
+	SECTION("Tagged types are projected and skipped.")
+	{
+		auto data = ByteVector::Create(Tagged{ 3, notes, "tagged" }, uint8_t{ 1 });
+		auto view = ByteView{ data };
+		CHECK(view.Read<Project<&Tagged::m_Name>>() == "tagged");
+		CHECK(view.Read<uint8_t>() == 1);
+		CHECK(ByteView{ data }.Skip<Tagged>().Read<uint8_t>() == 1);
+		CHECK(Counted::s_Constructions == 0);
+	}
+}
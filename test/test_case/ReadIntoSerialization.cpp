@@ -0,0 +1,196 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/ByteConverter.h"
+
+#include <map>
+#include <set>
+#include <unordered_map>
+
+using namespace FSecure;
+
+namespace ReadIntoSerialization
+{
+	struct Message
+	{
+		uint32_t m_Id;
+		std::string m_Name;
+		std::vector<uint16_t> m_Values;
+		std::map<std::string, std::vector<int>> m_Groups;
+		std::string m_NotSerialized;
+
+		bool operator==(Message const& other) const
+		{
+			return m_Id == other.m_Id && m_Name == other.m_Name && m_Values == other.m_Values && m_Groups == other.m_Groups;
+		}
+	};
+
+	/// Type with dedicated hook, counting calls.
+	struct Counted
+	{
+		uint32_t m_Value = 0;
+		inline static size_t s_ReadIntoCalls = 0;
+	};
+}
+
+namespace FSecure
+{
+	using namespace ReadIntoSerialization;
+
+	template <>
+	struct ByteConverter<Message> : PointerTupleConverter<Message>
+	{
+		static auto MemberPointers()
+		{
+			return std::make_tuple(&Message::m_Id, &Message::m_Name, &Message::m_Values, &Message::m_Groups);
+		}
+	};
+
+	template <>
+	struct ByteConverter<Counted>
+	{
+		static void To(Counted const& obj, ByteVector& bv)
+		{
+			bv.Store(obj.m_Value);
+		}
+
+		constexpr static size_t Size()
+		{
+			return sizeof(uint32_t);
+		}
+
+		static Counted From(ByteView& bv)
+		{
+			return { bv.Read<uint32_t>() };
+		}
+
+		static void From(ByteView& bv, Counted& obj)
+		{
+			++Counted::s_ReadIntoCalls;
+			bv.ReadInto(obj.m_Value);
+		}
+	};
+}
+
+TEST_CASE("ReadInto serialization.")
+{
+	using namespace ReadIntoSerialization;
+
+	SECTION("Result is the same as Read.")
+	{
+		auto message = Message{ 7, "name", { 1, 2, 3 }, { { "a", { 1, 2 } }, { "b", {} } }, "skipped" };
+		auto bv = ByteVector::Create(message);
+		auto target = Message{ 1, "old name which is long", { 9 }, { { "c", { 3 } } }, "kept" };
+		auto view = ByteView{ bv };
+		view.ReadInto(target);
+		CHECK(view.empty());
+		CHECK(target == message);
+		CHECK(target.m_NotSerialized == "kept");
+		CHECK(target == ByteView{ bv }.Read<Message>());
+	}
+
+	SECTION("Capacity of containers is reused.")
+	{
+		auto target = std::vector<std::string>{ std::string(100, 'x'), std::string(100, 'y') };
+		auto data = target.data();
+		auto stringData = target[0].data();
+		auto bv = ByteVector::Create(std::vector<std::string>{ "first", "second" });
+		ByteView{ bv }.ReadInto(target);
+		CHECK(target == std::vector<std::string>{ "first", "second" });
+		CHECK(target.data() == data);
+		CHECK(target[0].data() == stringData);
+	}
+
+	SECTION("Empty containers are read.")
+	{
+		auto bv = ByteVector::Create(std::vector<uint32_t>{}, std::vector<uint32_t>{});
+		auto target = std::vector<uint32_t>{ 1, 2, 3 };
+		auto view = ByteView{ bv };
+		view.ReadInto(target);
+		CHECK(target.empty());
+		CHECK(view.Read<std::vector<uint32_t>>().empty());
+		CHECK(view.empty());
+	}
+
+	SECTION("Nodes of maps are reused.")
+	{
+		auto source = std::map<uint32_t, std::string>{ { 1, "one" }, { 2, "two" }, { 3, "three" } };
+		auto target = std::map<uint32_t, std::string>{ { 10, "ten" }, { 20, "twenty" }, { 30, "thirty" } };
+		auto addresses = std::set<void const*>{};
+		for (auto const& e : target)
+			addresses.insert(&e);
+
+		auto bv = ByteVector::Create(source);
+		ByteView{ bv }.ReadInto(target);
+		CHECK(target == source);
+		for (auto const& e : target)
+			CHECK(addresses.count(&e));
+	}
+
+	SECTION("Containers of different sizes.")
+	{
+		auto target = std::unordered_map<uint32_t, std::vector<uint8_t>>{ { 1, { 1 } } };
+		auto source = std::unordered_map<uint32_t, std::vector<uint8_t>>{ { 2, { 2, 2 } }, { 3, {} }, { 4, { 4 } } };
+		auto bv = ByteVector::Create(source);
+		ByteView{ bv }.ReadInto(target);
+		CHECK(target == source);
+
+		bv = ByteVector::Create(std::unordered_map<uint32_t, std::vector<uint8_t>>{});
+		ByteView{ bv }.ReadInto(target);
+		CHECK(target.empty());
+	}
+
+	SECTION("Tuples, arrays and variants.")
+	{
+		using Tuple = std::tuple<std::string, std::array<std::vector<int>, 2>, std::variant<int, std::string>>;
+		auto source = Tuple{ "abc", { { { 1 }, { 2, 3 } } }, std::string{ "variant" } };
+		auto target = Tuple{ "xyz", {}, std::string(50, 'v') };
+		auto variantData = std::get<std::string>(std::get<2>(target)).data();
+		auto bv = ByteVector::Create(source);
+		ByteView{ bv }.ReadInto(target);
+		CHECK(target == source);
+		CHECK(std::get<std::string>(std::get<2>(target)).data() == variantData);
+
+		std::get<2>(source) = 5;
+		bv = ByteVector::Create(source);
+		ByteView{ bv }.ReadInto(target);
+		CHECK(target == source);
+	}
+
+	SECTION("Custom converters can provide hook.")
+	{
+		Counted::s_ReadIntoCalls = 0;
+		auto bv = ByteVector::Create(std::vector<Counted>{ { 1 }, { 2 } });
+		auto target = std::vector<Counted>{};
+		ByteView{ bv }.ReadInto(target);
+		REQUIRE(target.size() == 2);
+		CHECK(target[1].m_Value == 2);
+		CHECK(Counted::s_ReadIntoCalls == 2);
+	}
+
+	SECTION("ByteView is restored on failure.")
+	{
+		auto bv = ByteVector::Create(uint32_t{ 1 }, std::vector<uint32_t>{ 1, 2, 3 });
+		bv.resize(bv.size() - 1);
+		auto view = ByteView{ bv };
+		auto a = uint32_t{};
+		auto b = std::vector<uint32_t>{};
+		CHECK_THROWS(view.ReadInto(a, b));
+		CHECK(view.size() == bv.size());
+	}
+
+	SECTION("ByteReader assigns newly read objects.")
+	{
+		auto message = Message{ 7, "name", { 1, 2, 3 }, {}, "skipped" };
+		auto bv = ByteVector::Create(message);
+		auto target = Message{ 1, "old name", { 9 }, {}, "reset" };
+		auto view = ByteView{ bv };
+		ByteReader{ view }.Read(target);
+		CHECK(view.empty());
+		CHECK(target == message);
+		CHECK(target.m_NotSerialized.empty());
+
+		target.m_NotSerialized = "kept";
+		ByteView{ bv }.ReadInto(target);
+		CHECK(target.m_NotSerialized == "kept");
+	}
+}
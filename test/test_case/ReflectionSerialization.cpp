@@ -0,0 +1,199 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/ByteConverter.h"
+
+using namespace FSecure;
+
+namespace ReflectionSerialization
+{
+	enum class Color : uint16_t { red, green };
+
+	struct Packed
+	{
+		uint32_t m_A;
+		int16_t m_B;
+		Color m_C;
+
+		bool operator==(Packed const& other) const { return m_A == other.m_A && m_B == other.m_B && m_C == other.m_C; }
+	};
+
+	struct Nested
+	{
+		Packed m_Packed;
+		uint64_t m_D;
+	};
+
+	struct WithPadding
+	{
+		uint8_t m_A;
+		uint32_t m_B;
+	};
+
+	struct Message
+	{
+		uint32_t m_Id = 0;
+		std::string m_Name;
+		std::vector<Packed> m_Items;
+		std::optional<WithPadding> m_Extra;
+	};
+
+	struct Empty {};
+
+	struct HasConverter
+	{
+		uint32_t m_Value;
+	};
+
+	struct WithArray
+	{
+		uint32_t m_Id;
+		char m_Name[4];
+	};
+
+	template <typename T>
+	struct Wrap
+	{
+		T m_Value;
+	};
+}
+
+namespace FSecure
+{
+	using namespace ReflectionSerialization;
+
+	template <>
+	struct ByteConverter<Packed> : AggregateConverter<Packed> {};
+
+	template <>
+	struct ByteConverter<Nested> : AggregateConverter<Nested> {};
+
+	template <>
+	struct ByteConverter<WithPadding> : AggregateConverter<WithPadding> {};
+
+	template <>
+	struct ByteConverter<Message> : AggregateConverter<Message> {};
+
+	template <typename T>
+	struct ByteConverter<Wrap<T>>
+	{
+		static void To(Wrap<T> const& obj, ByteVector& bv)
+		{
+			bv.Store(obj.m_Value);
+		}
+
+		static size_t Size(Wrap<T> const& obj)
+		{
+			return ByteVector::Size(obj.m_Value);
+		}
+
+		static Wrap<T> From(ByteView& bv)
+		{
+			return { bv.Read<T>() };
+		}
+	};
+
+	template <>
+	struct ByteConverter<HasConverter>
+	{
+		static void To(HasConverter const& obj, ByteVector& bv)
+		{
+			bv.Store(static_cast<uint8_t>(obj.m_Value));
+		}
+
+		constexpr static size_t Size()
+		{
+			return sizeof(uint8_t);
+		}
+
+		static HasConverter From(ByteView& bv)
+		{
+			return { bv.Read<uint8_t>() };
+		}
+	};
+}
+
+TEST_CASE("Reflection serialization.")
+{
+	using namespace ReflectionSerialization;
+
+	SECTION("Members are detected.")
+	{
+		CHECK(Utils::Reflection::Arity<Packed> == 3);
+		CHECK(Utils::Reflection::Arity<Message> == 4);
+		CHECK(Utils::Reflection::IsReflectable<Nested>::value);
+		CHECK(!Utils::Reflection::IsReflectable<Empty>::value);
+		CHECK(!Utils::Reflection::IsReflectable<std::array<int, 2>>::value);
+		CHECK(!Utils::Reflection::IsReflectable<std::string>::value);
+		CHECK(Utils::Reflection::Arity<WithArray> != 2);
+		CHECK(!Utils::Reflection::IsReflectable<WithArray>::value);
+
+		auto packed = Packed{ 1, 2, Color::green };
+		std::get<1>(Utils::Reflection::Tie(packed)) = 5;
+		CHECK(packed.m_B == 5);
+	}
+
+	SECTION("Packed aggregates are trivially serializable.")
+	{
+		CHECK(ByteConverter<Packed>::TriviallySerializable);
+		CHECK(ByteConverter<Nested>::TriviallySerializable);
+		CHECK(!ByteConverter<WithPadding>::TriviallySerializable);
+		CHECK(!ByteConverter<Message>::TriviallySerializable);
+
+		constexpr auto size = ByteConverter<Packed>::Size();
+		CHECK(size == sizeof(Packed));
+
+		auto packed = Packed{ 1, -2, Color::green };
+		auto bv = ByteVector::Create(packed);
+		REQUIRE(bv.size() == sizeof(Packed));
+		CHECK(memcmp(bv.data(), &packed, sizeof(Packed)) == 0);
+		CHECK(ByteView{ bv }.Read<Packed>() == packed);
+	}
+
+	SECTION("Wire format equals listing all members.")
+	{
+		auto withPadding = WithPadding{ 1, 2 };
+		CHECK(ByteConverter<WithPadding>::Size() == sizeof(uint8_t) + sizeof(uint32_t));
+		CHECK(ByteVector::Create(withPadding) == ByteVector::Create(withPadding.m_A, withPadding.m_B));
+
+		auto nested = Nested{ { 1, 2, Color::red }, 3 };
+		CHECK(ByteVector::Create(nested) == ByteVector::Create(nested.m_Packed.m_A, nested.m_Packed.m_B, nested.m_Packed.m_C, nested.m_D));
+	}
+
+	SECTION("Vectors of packed aggregates.")
+	{
+		auto items = std::vector<Packed>{ { 1, 2, Color::red }, { 3, 4, Color::green }, { 5, 6, Color::red } };
+		auto bv = ByteVector::Create(items);
+		REQUIRE(bv.size() == sizeof(uint32_t) + items.size() * sizeof(Packed));
+		CHECK(memcmp(bv.data() + sizeof(uint32_t), items.data(), items.size() * sizeof(Packed)) == 0);
+		CHECK(ByteView{ bv }.Read<std::vector<Packed>>() == items);
+
+		auto array = std::array<Packed, 2>{ items[0], items[1] };
+		CHECK(ByteView{ ByteVector::Create(array) }.Read<std::array<Packed, 2>>() == array);
+	}
+
+	SECTION("Aggregates with dynamic members.")
+	{
+		auto message = Message{ 7, "name", { { 1, 2, Color::green } }, WithPadding{ 3, 4 } };
+		auto bv = ByteVector::Create(message);
+		CHECK(bv.size() == ByteVector::Size(message));
+		auto read = ByteView{ bv }.Read<Message>();
+		CHECK(read.m_Id == 7);
+		CHECK(read.m_Name == "name");
+		CHECK(read.m_Items == message.m_Items);
+		REQUIRE(read.m_Extra);
+		CHECK(read.m_Extra->m_B == 4);
+
+		auto target = Message{ 1, std::string(100, 'x'), {}, std::nullopt };
+		auto data = target.m_Name.data();
+		ByteView{ bv }.ReadInto(target);
+		CHECK(target.m_Name == "name");
+		CHECK(target.m_Name.data() == data);
+		CHECK(target.m_Extra);
+	}
+
+	SECTION("Aggregates without AggregateConverter use their own converters.")
+	{
+		CHECK(ByteVector::Create(HasConverter{ 5 }).size() == sizeof(uint8_t));
+		CHECK(ByteView{ ByteVector::Create(Wrap<int>{ 5 }) }.Read<Wrap<int>>().m_Value == 5);
+	}
+}
@@ -0,0 +1,114 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/ByteConverter.h"
+
+#include <thread>
+
+using namespace FSecure;
+
+#if defined(BYTE_CONVERTER_METRICS)
+namespace SerializationMetrics
+{
+	struct MeasuredType
+	{
+		uint32_t a;
+		std::string b;
+	};
+
+	/// Find statistics of type T in snapshot.
+	template <typename T>
+	Metrics::TypeStatistics Find(std::vector<Metrics::TypeStatistics> const& snapshot)
+	{
+		auto name = Metrics::Detail::TypeName(Metrics::Detail::Signature<T>());
+		for (auto const& e : snapshot)
+			if (e.m_Type == name)
+				return e;
+
+		return { name };
+	}
+}
+
+namespace FSecure
+{
+	using namespace SerializationMetrics;
+
+	template <>
+	struct ByteConverter<MeasuredType> : TupleConverter<MeasuredType>
+	{
+		static auto Convert(MeasuredType const& obj)
+		{
+			return Utils::MakeConversionTuple(obj.a, obj.b);
+		}
+	};
+}
+
+TEST_CASE("Serialization metrics.")
+{
+	Metrics::Reset();
+	auto object = MeasuredType{ 7, "seven" };
+	auto serializedSize = ByteVector::Size(object);
+
+	SECTION("Type names are readable.")
+	{
+		CHECK(Metrics::Detail::TypeName(Metrics::Detail::Signature<uint32_t>()).find("int") != std::string::npos);
+		CHECK(Metrics::Detail::TypeName(Metrics::Detail::Signature<MeasuredType>()).find("MeasuredType") != std::string::npos);
+	}
+
+	SECTION("Writes and reads are counted per type.")
+	{
+		auto bv = ByteVector::Create(object, object);
+		auto view = ByteView{ bv };
+		view.Read<MeasuredType>();
+
+		auto snapshot = Metrics::Snapshot();
+		auto measured = Find<MeasuredType>(snapshot);
+		CHECK(measured.m_Writes == 2);
+		CHECK(measured.m_BytesWritten == 2 * serializedSize);
+		CHECK(measured.m_Reads == 1);
+		CHECK(measured.m_BytesRead == serializedSize);
+
+		auto member = Find<std::string>(snapshot);
+		CHECK(member.m_Writes == 2);
+		CHECK(member.m_Reads == 1);
+		CHECK(member.m_BytesRead == ByteVector::Size(object.b));
+	}
+
+	SECTION("Counters of all threads are summed.")
+	{
+		std::thread{ [&] { ByteVector::Create(object); } }.join();
+		std::thread{ [&] { ByteVector::Create(object); } }.join();
+		CHECK(Find<MeasuredType>(Metrics::Snapshot()).m_Writes == 2);
+	}
+
+	SECTION("Blocks of finished threads are reused.")
+	{
+		auto countBlocks = []
+		{
+			auto ret = size_t{ 0 };
+			for (auto block = Metrics::Detail::g_Blocks.load(); block; block = block->m_Next)
+				++ret;
+
+			return ret;
+		};
+
+		std::thread{ [&] { ByteVector::Create(object); } }.join();
+		auto blocks = countBlocks();
+		for (auto i = 0; i < 10; ++i)
+			std::thread{ [&] { ByteVector::Create(object); } }.join();
+
+		CHECK(countBlocks() == blocks);
+		CHECK(Find<MeasuredType>(Metrics::Snapshot()).m_Writes == 11);
+	}
+
+	SECTION("Reset clears counters.")
+	{
+		ByteVector::Create(object);
+		std::thread{ [&] { ByteVector::Create(object); } }.join();
+		Metrics::Reset();
+		CHECK(Find<MeasuredType>(Metrics::Snapshot()).m_Writes == 0);
+
+		ByteVector::Create(object);
+		CHECK(Find<MeasuredType>(Metrics::Snapshot()).m_Writes == 1);
+	}
+}
+#endif
@@ -0,0 +1,83 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/Serialized.h"
+
+using namespace FSecure;
+
+namespace SerializedCache
+{
+	/// Type counting how many times it was serialized.
+	struct State
+	{
+		std::string m_Name;
+		std::vector<uint32_t> m_Values;
+
+		/// Number of calls of ByteConverter<State>::To.
+		static inline size_t s_ToCalls = 0;
+	};
+}
+
+namespace FSecure
+{
+	using namespace SerializedCache;
+
+	template <>
+	struct ByteConverter<State>
+	{
+		static void To(State const& obj, ByteVector& bv)
+		{
+			++State::s_ToCalls;
+			bv.Store(obj.m_Name, obj.m_Values);
+		}
+
+		static size_t Size(State const& obj)
+		{
+			return ByteVector::Size(obj.m_Name, obj.m_Values);
+		}
+
+		static State From(ByteView& bv)
+		{
+			auto [name, values] = bv.Read<std::string, std::vector<uint32_t>>();
+			return { std::move(name), std::move(values) };
+		}
+	};
+}
+
+TEST_CASE("Serialized cache.")
+{
+	using namespace SerializedCache;
+	State::s_ToCalls = 0;
+	auto state = Serialized<State>{ State{ "state", { 1, 2, 3 } } };
+
+	SECTION("Object is serialized once.")
+	{
+		CHECK(State::s_ToCalls == 0);
+		auto copy = state;
+		for (auto i = 0; i < 10; ++i)
+			ByteVector::Create(uint8_t{ 1 }, copy, std::make_tuple(state, uint16_t{ 2 }));
+
+		CHECK(State::s_ToCalls == 1);
+		CHECK(copy->m_Name == "state");
+	}
+
+	SECTION("Output is identical to serialized object.")
+	{
+		auto expected = ByteVector::Create(uint8_t{ 1 }, State{ "state", { 1, 2, 3 } });
+		State::s_ToCalls = 0;
+		CHECK(ByteVector::Create(uint8_t{ 1 }, state) == expected);
+		CHECK(ByteVector::Create(uint8_t{ 1 }, state) == expected);
+		CHECK(State::s_ToCalls == 1);
+
+		auto [number, read] = ByteView{ expected }.Read<uint8_t, Serialized<State>>();
+		CHECK(number == 1);
+		CHECK(read->m_Values == std::vector<uint32_t>{ 1, 2, 3 });
+		CHECK(read.Bytes() == state.Bytes());
+		CHECK(State::s_ToCalls == 1);
+	}
+
+	SECTION("Size of fixed size type is known at compile time.")
+	{
+		static_assert(ByteConverter<Serialized<uint64_t>>::Size() == sizeof(uint64_t));
+		CHECK(ByteVector::Create(Serialized<uint64_t>{ 5 }) == ByteVector::Create(uint64_t{ 5 }));
+	}
+}
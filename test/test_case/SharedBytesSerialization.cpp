@@ -0,0 +1,69 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/SharedBytes.h"
+
+#include <thread>
+
+using namespace FSecure;
+
+TEST_CASE("SharedBytes serialization.")
+{
+	auto body = ByteVector::Create(uint64_t{ 42 }, std::string{ "payload" });
+	auto buffer = SharedBytes{ ByteVector::Create(uint32_t{ 7 }, ByteView{ body }, ByteView{ body }) };
+
+	SECTION("Slices share allocation.")
+	{
+		auto slice = buffer.Slice(4, 10);
+		CHECK(slice.data() == buffer.data() + 4);
+		CHECK(slice.size() == 10);
+		CHECK(slice.UseCount() == 2);
+		CHECK(buffer.Slice(4).size() == buffer.size() - 4);
+		CHECK(buffer.Slice(buffer.size()).empty());
+		CHECK_THROWS_AS(buffer.Slice(buffer.size() + 1), std::out_of_range);
+		CHECK_FALSE(buffer.Slice(ByteView{ body }).has_value());
+	}
+
+	SECTION("Read returns slices of buffer.")
+	{
+		auto [number, first, second] = buffer.Read<uint32_t, SharedBytes, SharedBytes>();
+		CHECK(number == 7);
+		CHECK(first.View() == ByteView{ body });
+		CHECK(second.View() == ByteView{ body });
+		CHECK(first.data() == buffer.data() + sizeof(uint32_t) + sizeof(uint32_t));
+		CHECK(buffer.UseCount() == 3);
+		CHECK(first.Read<uint64_t, std::string>() == std::make_tuple(uint64_t{ 42 }, std::string{ "payload" }));
+	}
+
+	SECTION("Read without scope copies.")
+	{
+		auto view = buffer.View();
+		view.remove_prefix(sizeof(uint32_t));
+		auto copy = view.Read<SharedBytes>();
+		CHECK(copy.View() == ByteView{ body });
+		CHECK(copy.UseCount() == 1);
+		CHECK(buffer.UseCount() == 1);
+	}
+
+	SECTION("Written as ByteView.")
+	{
+		auto shared = SharedBytes{ ByteView{ body } };
+		CHECK(ByteVector::Create(shared, uint8_t{ 1 }) == ByteVector::Create(ByteView{ body }, uint8_t{ 1 }));
+		CHECK(ByteView{ ByteVector::Create(shared) }.Read<ByteVector>() == body);
+	}
+
+	SECTION("Slices keep buffer alive on other threads.")
+	{
+		auto payload = std::get<1>(buffer.Read<uint32_t, SharedBytes>());
+		buffer = SharedBytes{};
+		auto threads = std::vector<std::thread>{};
+		auto results = std::vector<uint64_t>(4);
+		for (auto i = size_t{ 0 }; i < results.size(); ++i)
+			threads.emplace_back([payload, &result = results[i]] { result = payload.Read<uint64_t>(); });
+
+		for (auto& thread : threads)
+			thread.join();
+
+		CHECK(std::all_of(results.begin(), results.end(), [](auto e) { return e == 42; }));
+		CHECK(payload.UseCount() == 1);
+	}
+}
@@ -0,0 +1,82 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/SharedMemoryChannel.h"
+
+#if defined(__linux__)
+
+#include <sys/wait.h>
+
+using namespace FSecure;
+
+TEST_CASE("Shared memory transfer.")
+{
+	auto name = "/ByteConverterTest" + std::to_string(getpid());
+
+	SECTION("Frames are passed between processes.")
+	{
+		constexpr auto messages = uint32_t{ 5000 };
+		auto channel = SharedMemoryChannel<>::Create(name, 4096);
+		CHECK_THROWS_AS(SharedMemoryChannel<>::Create(name, 4096), std::system_error);
+
+		auto child = fork();
+		REQUIRE(child != -1);
+		if (!child)
+		{
+			// Producer opens segment by name, and fills ring faster than consumer releases it.
+			auto code = 0;
+			BYTE_CONVERTER_TRY
+			{
+				auto producer = SharedMemoryChannel<>::Open(name);
+				for (auto i = uint32_t{ 0 }; i < messages; ++i)
+					producer.Write(i, std::string(i % 100, 'x'));
+			}
+			BYTE_CONVERTER_CATCH (...)
+			{
+				code = 1;
+			}
+
+			_exit(code);
+		}
+
+		auto received = uint32_t{ 0 };
+		auto ordered = true;
+		while (received < messages)
+		{
+			if (!channel.WaitForData(std::chrono::seconds{ 5 }))
+				break;
+
+			channel.Consume([&](ByteView frame)
+				{
+					auto [i, text] = frame.Read<uint32_t, std::string>();
+					ordered &= i == received && text.size() == i % 100;
+					++received;
+				}, 16);
+		}
+
+		auto status = 0;
+		CHECK(waitpid(child, &status, 0) == child);
+		CHECK(WIFEXITED(status));
+		CHECK(WEXITSTATUS(status) == 0);
+		CHECK(received == messages);
+		CHECK(ordered);
+	}
+
+	SECTION("Consumer wakes up after timeout.")
+	{
+		auto channel = SharedMemoryChannel<true>::Create(name, 1024);
+		CHECK_FALSE(channel.WaitForData(std::chrono::milliseconds{ 10 }));
+		auto producer = SharedMemoryChannel<true>::Open(name);
+		CHECK(producer.TryWrite(uint64_t{ 7 }));
+		CHECK(channel.WaitForData(std::chrono::milliseconds{ 10 }));
+		CHECK(channel.Next()->Read<uint64_t>() == 7);
+		channel.Release();
+	}
+
+	SECTION("Segment is removed with channel that created it.")
+	{
+		SharedMemoryChannel<>::Create(name, 1024);
+		CHECK_THROWS_AS(SharedMemoryChannel<>::Open(name), std::system_error);
+	}
+}
+
+#endif
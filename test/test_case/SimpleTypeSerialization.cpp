@@ -35,4 +35,14 @@ TEST_CASE("Simple type serialization.")
 		ByteVector serializedTogether = ByteVector::Create(testObject[0], testObject[1]);
 		REQUIRE((serializedSeparately[0].size() + serializedSeparately[1].size()) == serializedTogether.size());
 	}
+
+	SECTION("Empty contiguous containers are serialized.")
+	{
+		auto serialized = ByteVector::Create(std::vector<uint32_t>{}, std::array<uint32_t, 0>{}, std::string{});
+		CHECK(serialized.size() == 3 * sizeof(uint32_t));
+		auto [vector, array, string] = ByteView{ serialized }.Read<std::vector<uint32_t>, std::array<uint32_t, 0>, std::string>();
+		CHECK(vector.empty());
+		CHECK(array.empty());
+		CHECK(string.empty());
+	}
 };
@@ -0,0 +1,72 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/ByteConverter.h"
+
+using namespace FSecure;
+
+namespace SinglePassSerialization
+{
+	/// Type counting how many times it was measured.
+	struct Counted
+	{
+		std::string m_Value;
+
+		/// Number of calls of ByteConverter<Counted>::Size.
+		static inline size_t s_SizeCalls = 0;
+	};
+}
+
+namespace FSecure
+{
+	using namespace SinglePassSerialization;
+
+	template <>
+	struct ByteConverter<Counted>
+	{
+		static void To(Counted const& obj, ByteVector& bv)
+		{
+			bv.Write(obj.m_Value);
+		}
+
+		static size_t Size(Counted const& obj)
+		{
+			++Counted::s_SizeCalls;
+			return ByteVector::Size(obj.m_Value);
+		}
+
+		static Counted From(ByteView& bv)
+		{
+			return { bv.Read<std::string>() };
+		}
+	};
+}
+
+TEST_CASE("Single pass serialization.")
+{
+	using namespace SinglePassSerialization;
+	Counted::s_SizeCalls = 0;
+
+	SECTION("Each element of nested containers is measured once.")
+	{
+		auto nested = std::vector<std::vector<std::vector<Counted>>>{
+			{ { { "a" }, { "bb" } }, { { "ccc" } } },
+			{ {}, { { "dddd" }, { "e" }, { "f" } } },
+		};
+
+		auto bv = ByteVector::Create(nested);
+		CHECK(Counted::s_SizeCalls == 6);
+		CHECK(bv.size() == bv.capacity());
+
+		auto read = ByteView{ bv }.Read<decltype(nested)>();
+		REQUIRE(read.size() == nested.size());
+		CHECK(read[1][1][0].m_Value == "dddd");
+	}
+
+	SECTION("Output is not changed.")
+	{
+		auto nested = std::vector<std::vector<std::string>>{ { "a", "bc" }, {}, { "def" } };
+		auto expected = ByteVector{};
+		expected.Write(uint32_t{ 3 }, uint32_t{ 2 }, std::string{ "a" }, std::string{ "bc" }, uint32_t{ 0 }, uint32_t{ 1 }, std::string{ "def" });
+		CHECK(ByteVector::Create(nested) == expected);
+	}
+}
@@ -0,0 +1,151 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/TaggedConverter.h"
+#include "FSecure/ByteConverter/ByteSpan.h"
+
+using namespace FSecure;
+
+namespace TaggedConverterSerialization
+{
+	struct Old
+	{
+		uint32_t m_Id = 0;
+		std::string m_Name = "unnamed";
+	};
+
+	struct New
+	{
+		uint32_t m_Id = 0;
+		std::vector<uint16_t> m_Ports;
+		std::string m_Name = "unnamed";
+		std::optional<uint64_t> m_Flags;
+	};
+
+	struct Envelope
+	{
+		New m_Body;
+		uint8_t m_Version = 1;
+	};
+}
+
+namespace FSecure
+{
+	using namespace TaggedConverterSerialization;
+
+	template <>
+	struct ByteConverter<Old> : TaggedConverter<Old>
+	{
+		static auto TaggedMembers()
+		{
+			return std::make_tuple(TaggedMember{ 1, &Old::m_Id }, TaggedMember{ 2, &Old::m_Name });
+		}
+	};
+
+	template <>
+	struct ByteConverter<New> : TaggedConverter<New>
+	{
+		static auto TaggedMembers()
+		{
+			return std::make_tuple(TaggedMember{ 1, &New::m_Id }, TaggedMember{ 300, &New::m_Ports }, TaggedMember{ 2, &New::m_Name }, TaggedMember{ 4, &New::m_Flags });
+		}
+	};
+
+	template <>
+	struct ByteConverter<Envelope> : TaggedConverter<Envelope>
+	{
+		static auto TaggedMembers()
+		{
+			return std::make_tuple(TaggedMember{ 1, &Envelope::m_Body }, TaggedMember{ 2, &Envelope::m_Version });
+		}
+	};
+}
+
+TEST_CASE("Tagged serialization.")
+{
+	auto current = New{ 7, { 80, 443 }, "agent", 0x10 };
+
+	SECTION("Varint tags are encoded compactly.")
+	{
+		auto old = Old{ 3, "x" };
+		auto bv = ByteVector::Create(old);
+		CHECK(bv.size() == ByteVector::Size(old));
+		CHECK(bv.size() == sizeof(uint32_t) + (1 + sizeof(uint32_t) + sizeof(uint32_t)) + (1 + sizeof(uint32_t) + sizeof(uint32_t) + 1));
+		CHECK(ByteView{ bv }.Read<uint32_t>() == bv.size() - sizeof(uint32_t));
+		CHECK(Detail::VarintSize(127) == 1);
+		CHECK(Detail::VarintSize(128) == 2);
+		CHECK(Detail::VarintSize(0xffffffff) == 5);
+	}
+
+	SECTION("Data is read back.")
+	{
+		auto bv = ByteVector::Create(current, uint8_t{ 9 });
+		CHECK(bv.size() == ByteVector::Size(current, uint8_t{ 9 }));
+		auto [read, trailing] = ByteView{ bv }.Read<New, uint8_t>();
+		CHECK(read.m_Id == current.m_Id);
+		CHECK(read.m_Ports == current.m_Ports);
+		CHECK(read.m_Name == current.m_Name);
+		CHECK(read.m_Flags == current.m_Flags);
+		CHECK(trailing == 9);
+	}
+
+	SECTION("Old reader skips unknown fields.")
+	{
+		auto bv = ByteVector::Create(current, uint8_t{ 9 });
+		auto [old, trailing] = ByteView{ bv }.Read<Old, uint8_t>();
+		CHECK(old.m_Id == current.m_Id);
+		CHECK(old.m_Name == current.m_Name);
+		CHECK(trailing == 9);
+	}
+
+	SECTION("New reader defaults missing fields.")
+	{
+		auto bv = ByteVector::Create(Old{ 5, "legacy" });
+		auto read = ByteView{ bv }.Read<New>();
+		CHECK(read.m_Id == 5);
+		CHECK(read.m_Name == "legacy");
+		CHECK(read.m_Ports.empty());
+		CHECK(!read.m_Flags);
+	}
+
+	SECTION("Reading into existing object resets missing fields.")
+	{
+		auto target = current;
+		auto bv = ByteVector::Create(Old{ 5, "legacy" });
+		auto view = ByteView{ bv };
+		view.ReadInto(target);
+		CHECK(view.empty());
+		CHECK(target.m_Id == 5);
+		CHECK(target.m_Name == "legacy");
+		CHECK(target.m_Ports.empty());
+		CHECK(!target.m_Flags);
+	}
+
+	SECTION("Empty nullable fields are omitted.")
+	{
+		auto empty = current;
+		empty.m_Flags.reset();
+		CHECK(ByteVector::Size(current) - ByteVector::Size(empty) == 1 + sizeof(uint32_t) + sizeof(uint64_t));
+	}
+
+	SECTION("Nested tagged types are written into fixed buffers.")
+	{
+		auto envelope = Envelope{ current, 2 };
+		auto memory = std::array<uint8_t, 256>{};
+		auto span = ByteSpan{ memory.data(), memory.size() };
+		span.Write(envelope);
+		CHECK(ByteView{ span } == ByteView{ ByteVector::Create(envelope) });
+		auto view = ByteView{ span };
+		auto read = view.Read<Envelope>();
+		CHECK(read.m_Body.m_Ports == current.m_Ports);
+		CHECK(read.m_Version == 2);
+	}
+
+	SECTION("Truncated data is rejected.")
+	{
+		auto bv = ByteVector::Create(current);
+		CHECK_THROWS_AS(ByteView{ bv }.SubString(0, bv.size() - 1).Read<New>(), std::out_of_range);
+		auto corrupted = bv;
+		corrupted[sizeof(uint32_t) + 1] = 0xff;
+		CHECK_THROWS_AS(ByteView{ corrupted }.Read<New>(), std::out_of_range);
+	}
+}
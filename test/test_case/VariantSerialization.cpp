@@ -0,0 +1,74 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/ByteConverter.h"
+
+using namespace FSecure;
+
+TEST_CASE("Variant serialization.")
+{
+	using Fixed = std::variant<int32_t, uint32_t, float>;
+	using Mixed = std::variant<uint8_t, uint64_t>;
+	using Dynamic = std::variant<uint8_t, std::string>;
+	using Padded = PaddedVariant<uint8_t, uint64_t>;
+
+	SECTION("Size is constexpr when all alternatives have the same constant size.")
+	{
+		constexpr auto size = ByteConverter<Fixed>::Size();
+		CHECK(size == sizeof(size_t) + sizeof(int32_t));
+		CHECK(ByteVector::Create(Fixed{ 1.f }).size() == size);
+
+		using Deduction = Detail::ConverterDeduction<std::vector<Fixed>>::FunctionSize;
+		CHECK(Detail::ConverterDeduction<Fixed>::FunctionSize::value == Detail::SizeFunction::compileTime);
+		CHECK(Deduction::value == Detail::SizeFunction::runTime);
+		CHECK(ByteVector::Size(std::vector<Fixed>(10)) == sizeof(uint32_t) + 10 * size);
+	}
+
+	SECTION("Maximal size is constexpr when all alternatives have constant size.")
+	{
+		constexpr auto maxSize = ByteConverter<Mixed>::MaxSize();
+		CHECK(maxSize == sizeof(size_t) + sizeof(uint64_t));
+		CHECK(Detail::ConverterDeduction<Mixed>::FunctionSize::value == Detail::SizeFunction::runTime);
+		CHECK(ByteVector::Size(Mixed{ uint8_t{ 1 } }) == sizeof(size_t) + sizeof(uint8_t));
+		CHECK(Detail::ConverterDeduction<Dynamic>::FunctionSize::value == Detail::SizeFunction::runTime);
+	}
+
+	SECTION("Serialization round trip.")
+	{
+		for (auto const& var : { Mixed{ uint8_t{ 7 } }, Mixed{ uint64_t{ 1ull << 40 } } })
+		{
+			auto bv = ByteVector::Create(var, Dynamic{ std::string{ "text" } });
+			CHECK(bv.size() == ByteVector::Size(var, Dynamic{ std::string{ "text" } }));
+			auto [mixed, dynamic] = ByteView{ bv }.Read<Mixed, Dynamic>();
+			CHECK(mixed == var);
+			CHECK(std::get<std::string>(dynamic) == "text");
+		}
+	}
+
+	SECTION("Padded variant has fixed width.")
+	{
+		constexpr auto size = ByteConverter<Padded>::Size();
+		CHECK(size == sizeof(size_t) + sizeof(uint64_t));
+
+		auto small = ByteVector::Create(Padded{ uint8_t{ 3 } }, uint16_t{ 5 });
+		auto large = ByteVector::Create(Padded{ uint64_t{ 9 } }, uint16_t{ 5 });
+		CHECK(small.size() == size + sizeof(uint16_t));
+		CHECK(large.size() == small.size());
+		CHECK(ByteVector::Size(std::vector<Padded>(4)) == sizeof(uint32_t) + 4 * size);
+
+		auto [padded, next] = ByteView{ small }.Read<Padded, uint16_t>();
+		CHECK(std::get<uint8_t>(padded) == 3);
+		CHECK(next == 5);
+
+		auto view = ByteView{ large };
+		view.ReadInto(padded);
+		CHECK(std::get<uint64_t>(padded) == 9);
+		CHECK(view.Read<uint16_t>() == 5);
+	}
+
+	SECTION("Truncated padded variant throws.")
+	{
+		auto bv = ByteVector::Create(Padded{ uint8_t{ 3 } });
+		bv.resize(bv.size() - 1);
+		CHECK_THROWS(ByteView{ bv }.Read<Padded>());
+	}
+}
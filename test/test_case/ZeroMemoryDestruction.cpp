@@ -0,0 +1,34 @@
+#include "catch2/catch.hpp"
+
+#include "FSecure/ByteConverter/ByteConverter.h"
+
+#include <algorithm>
+
+using namespace FSecure;
+
+#if defined(BYTEVECTOR_ZERO_MEMORY_DESTRUCTION)
+TEST_CASE("Zero memory destruction.")
+{
+	auto isZeroed = [](std::uint8_t const* data, size_t size) { return std::all_of(data, data + size, [](auto e) { return e == 0; }); };
+
+	SECTION("Clear wipes data.")
+	{
+		auto bv = ByteVector::Create(uint64_t{ 0x0102030405060708 });
+		bv.Clear();
+		CHECK(isZeroed(bv.data(), bv.size()));
+	}
+
+	SECTION("Copied rvalue is wiped by Concat.")
+	{
+		auto target = ByteVector::Create(uint32_t{ 1 });
+		auto other = ByteVector::Create(uint64_t{ 0x0102030405060708 });
+		auto data = other.data();
+		auto size = other.size();
+		target.Concat(std::move(other));
+		CHECK(target.size() == sizeof(uint32_t) + sizeof(uint64_t));
+		CHECK(other.empty());
+		CHECK(other.data() == data);
+		CHECK(isZeroed(data, size));
+	}
+}
+#endif